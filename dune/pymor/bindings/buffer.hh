@@ -0,0 +1,313 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_BINDINGS_BUFFER_HH
+#define DUNE_PYMOR_BINDINGS_BUFFER_HH
+
+#include <Python.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <type_traits>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/eigen.hh>
+
+#include <dune/pymor/la/container/lincomb.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace Bindings {
+
+
+namespace internal {
+
+
+/**
+ * \brief A python object exporting a one dimensional array of doubles via the buffer protocol (PEP 3118).
+ *
+ *        Holds a reference to owner, the python object which owns vector, which in turn owns the memory.
+ */
+struct BufferExporter
+{
+  PyObject_HEAD
+  PyObject* owner;
+  const void* vector;
+  double* data;
+  Py_ssize_t size;
+  Py_ssize_t itemsize;
+}; // struct BufferExporter
+
+
+/**
+ * \brief The exported memory and the number of live exporters of each vector exported by buffer().
+ *
+ *        The bindings only run while holding the GIL, which serializes all accesses.
+ */
+struct Exports
+{
+  const double* data;
+  size_t count;
+}; // struct Exports
+
+
+inline std::map< const void*, Exports >& exports()
+{
+  static std::map< const void*, Exports > ret;
+  return ret;
+}
+
+
+//! the views of the python buffers mapped by map_buffer() (or copies of such vectors), one per vector
+inline std::map< const void*, Py_buffer >& mapped_views()
+{
+  static std::map< const void*, Py_buffer > ret;
+  return ret;
+}
+
+
+inline int buffer_exporter_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+  BufferExporter* exporter = reinterpret_cast< BufferExporter* >(self);
+  if (PyBuffer_FillInfo(view, self, exporter->data, exporter->size * exporter->itemsize, 0, flags) != 0)
+    return -1;
+  view->itemsize = exporter->itemsize;
+  if (flags & PyBUF_FORMAT)
+    view->format = const_cast< char* >("d");
+  if (flags & PyBUF_ND)
+    view->shape = &exporter->size;
+  if (flags & PyBUF_STRIDES)
+    view->strides = &exporter->itemsize;
+  return 0;
+} // ... buffer_exporter_getbuffer(...)
+
+
+inline void buffer_exporter_dealloc(PyObject* self)
+{
+  BufferExporter* exporter = reinterpret_cast< BufferExporter* >(self);
+  const auto result = exports().find(exporter->vector);
+  if (result != exports().end() && --(result->second.count) == 0)
+    exports().erase(result);
+  Py_XDECREF(exporter->owner);
+  PyObject_Del(self);
+}
+
+
+inline PyTypeObject* buffer_exporter_type()
+{
+  static PyBufferProcs procs;
+  static PyTypeObject type = { PyVarObject_HEAD_INIT(NULL, 0) "dune.pymor.BufferExporter" };
+  static bool ready = false;
+  if (!ready) {
+    procs.bf_getbuffer = buffer_exporter_getbuffer;
+    type.tp_basicsize = sizeof(BufferExporter);
+    type.tp_dealloc = buffer_exporter_dealloc;
+    type.tp_as_buffer = &procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+#ifdef Py_TPFLAGS_HAVE_NEWBUFFER
+    type.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+    if (PyType_Ready(&type) != 0)
+      return NULL;
+    ready = true;
+  }
+  return &type;
+} // ... buffer_exporter_type(...)
+
+
+/**
+ * \brief Gets a contiguous, one dimensional view of doubles of exporter (with the given additional flags).
+ *
+ *        Throws if exporter does not provide such a view, otherwise the caller has to release view.
+ */
+inline void get_buffer(PyObject* exporter, const int flags, Py_buffer& view)
+{
+  if (PyObject_GetBuffer(exporter, &view, flags | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+    PyErr_Clear();
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "exporter does not provide a " << ((flags & PyBUF_WRITABLE) ? "writable " : "")
+               << "contiguous buffer!");
+  }
+  const std::string format = (view.format == NULL) ? std::string("B") : std::string(view.format);
+  const bool matches = view.ndim == 1
+                       && view.itemsize == Py_ssize_t(sizeof(double))
+                       && (format == "d" || format == "<d" || format == "=d" || format == "@d");
+  if (!matches) {
+    PyBuffer_Release(&view);
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "exporter has to provide a one dimensional buffer of doubles (format is '" << format << "')!");
+  }
+} // ... get_buffer(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief Calls functor(data, size) with the entries of a contiguous, one dimensional python buffer of doubles (e.g., a
+ *        numpy array), without copying them. The view is released afterwards, functor must not keep data.
+ */
+template< class FunctorType >
+void read_buffer(PyObject* exporter, FunctorType functor)
+{
+  Py_buffer view;
+  internal::get_buffer(exporter, PyBUF_SIMPLE, view);
+  try {
+    functor(static_cast< const double* >(view.buf), size_t(view.len / view.itemsize));
+  } catch (...) {
+    PyBuffer_Release(&view);
+    throw;
+  }
+  PyBuffer_Release(&view);
+} // ... read_buffer(...)
+
+
+//! the number of live views of vector created by buffer()
+template< class VectorType >
+size_t num_exports(const VectorType& vector)
+{
+  const auto result = internal::exports().find(&vector);
+  return (result == internal::exports().end()) ? 0 : result->second.count;
+}
+
+
+/**
+ * \brief Returns a writable memoryview (PEP 3118, format 'd') of the entries of vector, without copying them.
+ *
+ *        The view references owner (the python object wrapping vector), which is thus kept alive as long as the view
+ *        (or any numpy array created from it) exists. The containers share their storage on copy and move a shared
+ *        storage to new memory on the first write (copy on write), which would detach vector from the view. Thus all
+ *        copies of vector created by the bindings are deep copies while a view exists (see create()), and a storage
+ *        which has been replaced nevertheless (e.g., on the C++ side) is rejected with a BufferError on the next call.
+ *        Returns NULL with a python exception set on failure.
+ */
+template< class VectorType >
+PyObject* buffer(VectorType& vector, PyObject* owner)
+{
+  typedef LA::internal::DenseAccess< VectorType > AccessType;
+  static_assert(AccessType::available, "VectorType does not provide dense access!");
+  static_assert(std::is_same< typename AccessType::ScalarType, double >::value, "Only implemented for double!");
+  if (AccessType::num_chunks(vector) > 1) {
+    PyErr_SetString(PyExc_TypeError, "the storage of vector is not contiguous!");
+    return NULL;
+  }
+  const size_t size = AccessType::chunk_size(vector);
+  const auto exported = internal::exports().find(&vector);
+  if (exported != internal::exports().end()
+      && (size == 0 || exported->second.data != AccessType::chunk(static_cast< const VectorType& >(vector), 0))) {
+    PyErr_SetString(PyExc_BufferError, "the storage of vector has been replaced while a view of it exists!");
+    return NULL;
+  }
+  PyTypeObject* type = internal::buffer_exporter_type();
+  if (type == NULL)
+    return NULL;
+  internal::BufferExporter* exporter = PyObject_New(internal::BufferExporter, type);
+  if (exporter == NULL)
+    return NULL;
+  Py_INCREF(owner);
+  exporter->owner = owner;
+  exporter->vector = &vector;
+  // chunk() also ensures that the data of vector is not shared with other vectors
+  exporter->data = (size > 0) ? AccessType::chunk(vector, 0) : nullptr;
+  exporter->size = Py_ssize_t(size);
+  exporter->itemsize = Py_ssize_t(sizeof(double));
+  internal::Exports& exports = internal::exports()[&vector];
+  exports.data = exporter->data;
+  ++exports.count;
+  PyObject* ret = PyMemoryView_FromObject(reinterpret_cast< PyObject* >(exporter));
+  Py_DECREF(exporter);
+  return ret;
+} // ... buffer(...)
+
+
+/**
+ * \brief Creates the instances of wrapped containers, which support buffer() or map_buffer(), in the bindings.
+ *
+ *        Copies of an exported container are deep copies, such that its storage is never shared and thus never
+ *        replaced while a view exists (see buffer()). Copies of a mapped vector keep the mapped python buffer alive
+ *        as well (see map_buffer()).
+ */
+template< class ContainerType, class... Args >
+ContainerType* create(Args&&... args)
+{
+  return new ContainerType(std::forward< Args >(args)...);
+}
+
+
+template< class ContainerType >
+ContainerType* create(const ContainerType& other)
+{
+  ContainerType* ret = (num_exports(other) > 0) ? new ContainerType(other.copy()) : new ContainerType(other);
+  auto& views = internal::mapped_views();
+  const auto view = views.find(&other);
+  if (view != views.end()) {
+    Py_buffer copy;
+    try {
+      internal::get_buffer(view->second.obj, PyBUF_WRITABLE, copy);
+    } catch (...) {
+      delete ret;
+      throw;
+    }
+    views[ret] = copy;
+  }
+  return ret;
+} // ... create(...)
+
+
+template< class ContainerType >
+ContainerType* create(ContainerType& other)
+{
+  return create< ContainerType >(static_cast< const ContainerType& >(other));
+}
+
+
+/**
+ * \brief Deletes the instances of wrapped containers in the bindings, releasing their mapped python buffer (if any).
+ */
+template< class ContainerType >
+void release(ContainerType* container)
+{
+  auto& views = internal::mapped_views();
+  const auto view = views.find(container);
+  if (view != views.end()) {
+    PyBuffer_Release(&view->second);
+    views.erase(view);
+  }
+  delete container;
+} // ... release(...)
+
+
+#if HAVE_EIGEN
+
+
+/**
+ * \brief Wraps the memory of a writable, contiguous, one dimensional python buffer of doubles (e.g., a numpy array) as
+ *        a new EigenMappedDenseVector, without copying it.
+ *
+ *        The vector holds a view of exporter until it is deleted by release(), which keeps exporter alive (and, for a
+ *        numpy array, prevents it from being resized).
+ */
+template< class ScalarType >
+Stuff::LA::EigenMappedDenseVector< ScalarType >* map_buffer(PyObject* exporter)
+{
+  static_assert(std::is_same< ScalarType, double >::value, "Only implemented for double!");
+  Py_buffer view;
+  internal::get_buffer(exporter, PyBUF_WRITABLE, view);
+  auto ret = new Stuff::LA::EigenMappedDenseVector< ScalarType >(static_cast< ScalarType* >(view.buf),
+                                                                 size_t(view.len / view.itemsize));
+  internal::mapped_views()[ret] = view;
+  return ret;
+} // ... map_buffer(...)
+
+
+#endif // HAVE_EIGEN
+
+
+} // namespace Bindings
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_BINDINGS_BUFFER_HH
@@ -13,10 +13,12 @@
 #include <dune/pymor/functionals/default.hh>
 #include <dune/pymor/functionals/interfaces.hh>
 #include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/la/container/multivector.hh>
 #include <dune/pymor/operators/base.hh>
 #include <dune/pymor/operators/affine.hh>
 #include <dune/pymor/operators/interfaces.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/parameters/sampling.hh>
 
 #endif // DUNE_PYMOR_BINDINGS_PYMOR_HH
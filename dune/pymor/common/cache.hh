@@ -0,0 +1,380 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_CACHE_HH
+#define DUNE_PYMOR_COMMON_CACHE_HH
+
+#include <list>
+#include <map>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief A thread safe cache of bounded size, which evicts the least recently used entry.
+ *
+ *        The values are held by shared_ptr, such that an entry handed out by get() stays valid after its eviction. A
+ *        capacity of 0 disables the cache.
+ */
+template< class KeyImp, class ValueImp, class HashImp = std::hash< KeyImp > >
+class LRUCache
+{
+public:
+  typedef KeyImp   KeyType;
+  typedef ValueImp ValueType;
+
+private:
+  typedef std::list< std::pair< KeyType, std::shared_ptr< const ValueType > > > ListType;
+
+public:
+  explicit LRUCache(const size_t cap)
+    : capacity_(cap)
+  {}
+
+  LRUCache(const LRUCache& other) = delete;
+
+  LRUCache& operator=(const LRUCache& other) = delete;
+
+  size_t capacity() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return capacity_;
+  }
+
+  void set_capacity(const size_t cap)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    capacity_ = cap;
+    shrink();
+  }
+
+  size_t size() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return entries_.size();
+  }
+
+  void clear()
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    entries_.clear();
+    positions_.clear();
+  }
+
+  /**
+   * \brief Returns the value stored for key (and marks it as most recently used), or nullptr.
+   */
+  std::shared_ptr< const ValueType > get(const KeyType& key) const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    const auto search_result = positions_.find(key);
+    if (search_result == positions_.end())
+      return nullptr;
+    entries_.splice(entries_.begin(), entries_, search_result->second);
+    return search_result->second->second;
+  } // ... get(...)
+
+  void insert(const KeyType& key, const std::shared_ptr< const ValueType > value)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (capacity_ == 0)
+      return;
+    const auto search_result = positions_.find(key);
+    if (search_result != positions_.end()) {
+      search_result->second->second = value;
+      entries_.splice(entries_.begin(), entries_, search_result->second);
+      return;
+    }
+    entries_.emplace_front(key, value);
+    positions_.insert(std::make_pair(key, entries_.begin()));
+    shrink();
+  } // ... insert(...)
+
+  /**
+   * \brief Returns the value stored for key, or creates, stores and returns it.
+   *
+   *        The creator is called without holding the lock, concurrent misses on the same key may thus both create a
+   *        value, of which only one is retained.
+   */
+  template< class CreatorType >
+  std::shared_ptr< const ValueType > get_or_create(const KeyType& key, const CreatorType& creator)
+  {
+    auto ret = get(key);
+    if (ret)
+      return ret;
+    ret = std::make_shared< const ValueType >(creator());
+    insert(key, ret);
+    return ret;
+  } // ... get_or_create(...)
+
+private:
+  void shrink()
+  {
+    while (entries_.size() > capacity_) {
+      positions_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  } // ... shrink(...)
+
+  size_t capacity_;
+  mutable std::mutex mutex_;
+  mutable ListType entries_;
+  std::unordered_map< KeyType, typename ListType::iterator, HashImp > positions_;
+}; // class LRUCache
+
+
+enum class EvictionPolicy
+{
+  least_recently_used,
+  least_frequently_used
+}; // enum class EvictionPolicy
+
+
+struct CacheStatistics
+{
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t entries;
+  size_t weight;
+}; // struct CacheStatistics
+
+
+/**
+ * \brief A thread safe cache, the total weight of which is bounded by a budget.
+ *
+ *        The entries are distributed among a number of shards by their hash, each of which is guarded by its own mutex,
+ *        such that concurrent accesses to different keys rarely contend. The budget applies to the total weight of all
+ *        shards: once it is exceeded, entries are evicted according to the policy from whichever shard holds the next
+ *        victim (the least frequently used entries are evicted in the order of their last use if used equally often).
+ *        Each shard keeps its entries ordered by the policy, such that the victim of a shard is found in constant time.
+ *        Concurrent inserts may exceed the budget until their evictions are done. Entries heavier than the whole
+ *        budget are not stored at all.
+ */
+template< class KeyImp, class ValueImp, class HashImp = std::hash< KeyImp > >
+class ShardedCache
+{
+public:
+  typedef KeyImp   KeyType;
+  typedef ValueImp ValueType;
+
+private:
+  //! (number of uses (only for least_frequently_used), time of last use), the smallest one is evicted first
+  typedef std::pair< size_t, size_t > RankType;
+
+  struct Entry
+  {
+    std::shared_ptr< const ValueType > value;
+    size_t weight;
+    size_t last_use;
+    size_t uses;
+    //! the key of this entry in Shard::ranks
+    RankType rank;
+  }; // struct Entry
+
+  struct Shard
+  {
+    std::mutex mutex;
+    std::unordered_map< KeyType, Entry, HashImp > entries;
+    std::map< RankType, KeyType > ranks;
+    size_t weight = 0;
+  }; // struct Shard
+
+public:
+  explicit ShardedCache(const size_t bdgt = std::numeric_limits< size_t >::max(),
+                        const EvictionPolicy plcy = EvictionPolicy::least_recently_used,
+                        const size_t num_shrds = 16)
+    : budget_(bdgt)
+    , policy_(plcy)
+    , weight_(0)
+    , clock_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0)
+  {
+    for (size_t ii = 0; ii < std::max(num_shrds, size_t(1)); ++ii)
+      shards_.emplace_back(new Shard());
+  }
+
+  ShardedCache(const ShardedCache& other) = delete;
+
+  ShardedCache& operator=(const ShardedCache& other) = delete;
+
+  size_t num_shards() const
+  {
+    return shards_.size();
+  }
+
+  size_t budget() const
+  {
+    return budget_;
+  }
+
+  /**
+   * \brief Sets the budget and evicts entries until it is met.
+   */
+  void set_budget(const size_t bdgt)
+  {
+    budget_ = bdgt;
+    shrink();
+  }
+
+  EvictionPolicy policy() const
+  {
+    return policy_;
+  }
+
+  void set_policy(const EvictionPolicy plcy)
+  {
+    policy_ = plcy;
+    for (auto& shard : shards_) {
+      std::lock_guard< std::mutex > lock(shard->mutex);
+      shard->ranks.clear();
+      for (auto& element : shard->entries) {
+        element.second.rank = rank(element.second);
+        shard->ranks.insert(std::make_pair(element.second.rank, element.first));
+      }
+    }
+  } // ... set_policy(...)
+
+  std::shared_ptr< const ValueType > get(const KeyType& key)
+  {
+    Shard& shard = shard_of(key);
+    std::lock_guard< std::mutex > lock(shard.mutex);
+    const auto search_result = shard.entries.find(key);
+    if (search_result == shard.entries.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    Entry& entry = search_result->second;
+    shard.ranks.erase(entry.rank);
+    entry.last_use = ++clock_;
+    ++entry.uses;
+    entry.rank = rank(entry);
+    shard.ranks.insert(std::make_pair(entry.rank, key));
+    return entry.value;
+  } // ... get(...)
+
+  void insert(const KeyType& key, const std::shared_ptr< const ValueType > value, const size_t weight)
+  {
+    Shard& shard = shard_of(key);
+    {
+      std::lock_guard< std::mutex > lock(shard.mutex);
+      const auto search_result = shard.entries.find(key);
+      if (search_result != shard.entries.end())
+        erase(shard, search_result);
+    }
+    if (weight > budget_)
+      return;
+    // make room first, such that the new entry is not evicted right away
+    weight_ += weight;
+    shrink();
+    std::lock_guard< std::mutex > lock(shard.mutex);
+    const auto search_result = shard.entries.find(key);
+    if (search_result != shard.entries.end())
+      erase(shard, search_result);
+    Entry entry{value, weight, ++clock_, 0, RankType()};
+    entry.rank = rank(entry);
+    shard.ranks.insert(std::make_pair(entry.rank, key));
+    shard.entries.insert(std::make_pair(key, entry));
+    shard.weight += weight;
+  } // ... insert(...)
+
+  void clear()
+  {
+    for (auto& shard : shards_) {
+      std::lock_guard< std::mutex > lock(shard->mutex);
+      weight_ -= shard->weight;
+      shard->entries.clear();
+      shard->ranks.clear();
+      shard->weight = 0;
+    }
+  } // ... clear(...)
+
+  CacheStatistics statistics() const
+  {
+    CacheStatistics ret{hits_, misses_, evictions_, 0, 0};
+    for (auto& shard : shards_) {
+      std::lock_guard< std::mutex > lock(shard->mutex);
+      ret.entries += shard->entries.size();
+      ret.weight += shard->weight;
+    }
+    return ret;
+  } // ... statistics(...)
+
+private:
+  Shard& shard_of(const KeyType& key) const
+  {
+    return *shards_[HashImp()(key) % shards_.size()];
+  }
+
+  RankType rank(const Entry& entry) const
+  {
+    return RankType((policy_ == EvictionPolicy::least_frequently_used) ? entry.uses : 0, entry.last_use);
+  }
+
+  void erase(Shard& shard, const typename std::unordered_map< KeyType, Entry, HashImp >::iterator position)
+  {
+    shard.ranks.erase(position->second.rank);
+    shard.weight -= position->second.weight;
+    weight_ -= position->second.weight;
+    shard.entries.erase(position);
+  } // ... erase(...)
+
+  /**
+   * \brief Evicts the first victim among all shards until the total weight meets the budget.
+   *
+   *        Only one shard is locked at a time. The victim is determined by looking at the first rank of each shard,
+   *        if the shard changed in between, its new first entry is evicted instead.
+   */
+  void shrink()
+  {
+    while (weight_ > budget_) {
+      Shard* victim_shard = nullptr;
+      RankType victim_rank;
+      for (auto& shard : shards_) {
+        std::lock_guard< std::mutex > lock(shard->mutex);
+        if (!shard->ranks.empty() && (victim_shard == nullptr || shard->ranks.begin()->first < victim_rank)) {
+          victim_shard = shard.get();
+          victim_rank = shard->ranks.begin()->first;
+        }
+      }
+      if (victim_shard == nullptr)
+        return;
+      std::lock_guard< std::mutex > lock(victim_shard->mutex);
+      if (victim_shard->ranks.empty())
+        continue;
+      erase(*victim_shard, victim_shard->entries.find(victim_shard->ranks.begin()->second));
+      ++evictions_;
+    }
+  } // ... shrink(...)
+
+  std::atomic< size_t > budget_;
+  std::atomic< EvictionPolicy > policy_;
+  //! the total weight of all shards
+  std::atomic< size_t > weight_;
+  std::atomic< size_t > clock_;
+  std::atomic< size_t > hits_;
+  std::atomic< size_t > misses_;
+  std::atomic< size_t > evictions_;
+  std::vector< std::unique_ptr< Shard > > shards_;
+}; // class ShardedCache
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_CACHE_HH
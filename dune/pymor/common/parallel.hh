@@ -0,0 +1,79 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_PARALLEL_HH
+#define DUNE_PYMOR_COMMON_PARALLEL_HH
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief The number of threads to use if 0 is requested: the number of hardware threads (at least 1).
+ */
+inline size_t default_num_threads()
+{
+  return std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+}
+
+
+/**
+ * \brief Calls functor(ii, thread) for each ii in [0, size) on num_threads threads (default_num_threads() if 0).
+ *
+ *        The indices are handed out one at a time, such that threads which finish early pick up the remaining work
+ *        (which balances tasks of very different duration). thread is the number of the calling thread in
+ *        [0, num_threads) and may be used to access per thread state. The first exception thrown by any call is
+ *        rethrown once all threads are done, the remaining indices are skipped in that case.
+ */
+template< class FunctorType >
+void parallel_for(const size_t size, const FunctorType& functor, size_t num_threads = 0)
+{
+  if (num_threads == 0)
+    num_threads = default_num_threads();
+  num_threads = std::min(num_threads, size);
+  if (num_threads <= 1) {
+    for (size_t ii = 0; ii < size; ++ii)
+      functor(ii, size_t(0));
+    return;
+  }
+  std::atomic< size_t > next(0);
+  std::atomic< bool > failed(false);
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  const auto work = [&](const size_t thread) {
+    for (size_t ii = next++; ii < size && !failed; ii = next++) {
+      try {
+        functor(ii, thread);
+      } catch (...) {
+        std::lock_guard< std::mutex > lock(exception_mutex);
+        if (!failed)
+          exception = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+  std::vector< std::thread > threads;
+  threads.reserve(num_threads - 1);
+  for (size_t tt = 1; tt < num_threads; ++tt)
+    threads.emplace_back(work, tt);
+  work(0);
+  for (auto& thread : threads)
+    thread.join();
+  if (exception)
+    std::rethrow_exception(exception);
+} // ... parallel_for(...)
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_PARALLEL_HH
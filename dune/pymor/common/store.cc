@@ -0,0 +1,278 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <dune/common/exceptions.hh>
+
+#include "store.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+static const char store_magic[8] = {'D', 'P', 'Y', 'M', 'S', 'T', 'O', '1'};
+static const uint64_t record_marker = 0x44524f434552594dull;
+//! marker, key size, value size, checksum
+static const uint64_t record_header_size = 4 * sizeof(uint64_t);
+
+
+static uint64_t padded(const uint64_t size)
+{
+  return (size + 7) & ~uint64_t(7);
+}
+
+
+static void write_all(const int file, const char* data, size_t size, off_t offset, const std::string& filename)
+{
+  while (size > 0) {
+    const ssize_t written = ::pwrite(file, data, size, offset);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      DUNE_THROW(IOError, "could not write to '" << filename << "' (" << std::strerror(errno) << ")!");
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+} // ... write_all(...)
+
+
+static bool read_all(const int file, char* data, size_t size, off_t offset)
+{
+  while (size > 0) {
+    const ssize_t read = ::pread(file, data, size, offset);
+    if (read < 0 && errno == EINTR)
+      continue;
+    if (read <= 0)
+      return false;
+    data += read;
+    size -= read;
+    offset += read;
+  }
+  return true;
+} // ... read_all(...)
+
+
+static uint64_t read_uint(const char* data)
+{
+  uint64_t ret;
+  std::memcpy(&ret, data, sizeof(uint64_t));
+  return ret;
+}
+
+
+static void append_uint(std::vector< char >& buffer, const uint64_t value)
+{
+  const char* data = reinterpret_cast< const char* >(&value);
+  buffer.insert(buffer.end(), data, data + sizeof(uint64_t));
+}
+
+
+} // namespace internal
+
+
+uint64_t stable_hash(const void* data, const size_t size, const uint64_t seed)
+{
+  const unsigned char* bytes = static_cast< const unsigned char* >(data);
+  uint64_t ret = seed;
+  for (size_t ii = 0; ii < size; ++ii) {
+    ret ^= bytes[ii];
+    ret *= 1099511628211ull;
+  }
+  return ret;
+} // ... stable_hash(...)
+
+
+// ===========================
+// ===== AppendOnlyStore =====
+// ===========================
+AppendOnlyStore::AppendOnlyStore(const std::string filename, const std::string signature, const bool overwrite)
+  : filename_(filename)
+  , file_(-1)
+  , end_(0)
+  , mapping_(nullptr)
+  , mapped_size_(0)
+{
+  file_ = ::open(filename_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file_ < 0)
+    DUNE_THROW(IOError, "could not open '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  try {
+    open(signature, overwrite);
+  } catch (...) {
+    ::close(file_);
+    throw;
+  }
+}
+
+AppendOnlyStore::~AppendOnlyStore()
+{
+  unmap();
+  if (file_ >= 0)
+    ::close(file_);
+}
+
+const std::string& AppendOnlyStore::filename() const
+{
+  return filename_;
+}
+
+size_t AppendOnlyStore::size() const
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  return index_.size();
+}
+
+bool AppendOnlyStore::contains(const std::string& key) const
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  return index_.count(key) > 0;
+}
+
+bool AppendOnlyStore::get(const std::string& key, std::string& ret) const
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  const auto search_result = index_.find(key);
+  if (search_result == index_.end())
+    return false;
+  const Location& location = search_result->second;
+  map(end_);
+  ret.assign(mapping_ + location.offset, location.size);
+  return true;
+} // ... get(...)
+
+void AppendOnlyStore::put(const std::string& key, const std::string& value)
+{
+  std::vector< char > buffer;
+  buffer.reserve(internal::record_header_size + internal::padded(key.size() + value.size()));
+  internal::append_uint(buffer, internal::record_marker);
+  internal::append_uint(buffer, key.size());
+  internal::append_uint(buffer, value.size());
+  internal::append_uint(buffer, stable_hash(value.data(), value.size(), stable_hash(key.data(), key.size())));
+  buffer.insert(buffer.end(), key.begin(), key.end());
+  buffer.insert(buffer.end(), value.begin(), value.end());
+  buffer.resize(internal::record_header_size + internal::padded(key.size() + value.size()), 0);
+  std::lock_guard< std::mutex > lock(mutex_);
+  internal::write_all(file_, buffer.data(), buffer.size(), end_, filename_);
+  index_[key] = Location{end_ + internal::record_header_size + key.size(), value.size()};
+  end_ += buffer.size();
+} // ... put(...)
+
+void AppendOnlyStore::open(const std::string& signature, const bool overwrite)
+{
+  struct stat file_stat;
+  if (::fstat(file_, &file_stat) != 0)
+    DUNE_THROW(IOError, "could not stat '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  const uint64_t file_size = file_stat.st_size;
+  if (file_size == 0) {
+    start_anew(signature);
+    return;
+  }
+  // never touch a file we did not write
+  char magic[sizeof(internal::store_magic)];
+  if (file_size < sizeof(magic)
+      || !internal::read_all(file_, magic, sizeof(magic), 0)
+      || std::memcmp(magic, internal::store_magic, sizeof(magic)) != 0)
+    DUNE_THROW(IOError, "'" << filename_ << "' is not a store (unknown format), refusing to touch it!");
+  const uint64_t header_size = sizeof(internal::store_magic) + sizeof(uint64_t) + internal::padded(signature.size());
+  std::vector< char > header(header_size);
+  if (file_size < header_size
+      || !internal::read_all(file_, header.data(), header_size, 0)
+      || internal::read_uint(header.data() + sizeof(internal::store_magic)) != signature.size()
+      || signature.compare(0,
+                           signature.size(),
+                           header.data() + sizeof(internal::store_magic) + sizeof(uint64_t),
+                           signature.size()) != 0) {
+    if (!overwrite)
+      DUNE_THROW(IOError,
+                 "'" << filename_ << "' is a store with a different signature (or a corrupted header), refusing to "
+                 << "discard its contents (pass overwrite = true to do so)!");
+    start_anew(signature);
+    return;
+  }
+  end_ = header_size;
+  scan();
+  if (end_ < uint64_t(file_stat.st_size)) {
+    unmap();
+    if (::ftruncate(file_, end_) != 0)
+      DUNE_THROW(IOError, "could not truncate '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  }
+} // ... open(...)
+
+void AppendOnlyStore::start_anew(const std::string& signature)
+{
+  unmap();
+  index_.clear();
+  if (::ftruncate(file_, 0) != 0)
+    DUNE_THROW(IOError, "could not truncate '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  std::vector< char > header(internal::store_magic, internal::store_magic + sizeof(internal::store_magic));
+  internal::append_uint(header, signature.size());
+  header.insert(header.end(), signature.begin(), signature.end());
+  header.resize(sizeof(internal::store_magic) + sizeof(uint64_t) + internal::padded(signature.size()), 0);
+  internal::write_all(file_, header.data(), header.size(), 0, filename_);
+  end_ = header.size();
+} // ... start_anew(...)
+
+void AppendOnlyStore::scan()
+{
+  struct stat file_stat;
+  if (::fstat(file_, &file_stat) != 0)
+    DUNE_THROW(IOError, "could not stat '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  const uint64_t file_size = file_stat.st_size;
+  map(file_size);
+  uint64_t offset = end_;
+  while (offset + internal::record_header_size <= file_size) {
+    const char* record = mapping_ + offset;
+    const uint64_t key_size = internal::read_uint(record + sizeof(uint64_t));
+    const uint64_t value_size = internal::read_uint(record + 2 * sizeof(uint64_t));
+    if (internal::read_uint(record) != internal::record_marker
+        || key_size > file_size || value_size > file_size
+        || offset + internal::record_header_size + internal::padded(key_size + value_size) > file_size)
+      break;
+    const char* key = record + internal::record_header_size;
+    const char* value = key + key_size;
+    if (internal::read_uint(record + 3 * sizeof(uint64_t))
+        != stable_hash(value, value_size, stable_hash(key, key_size)))
+      break;
+    index_[std::string(key, key_size)] = Location{offset + internal::record_header_size + key_size, value_size};
+    offset += internal::record_header_size + internal::padded(key_size + value_size);
+  }
+  end_ = offset;
+} // ... scan(...)
+
+void AppendOnlyStore::map(const uint64_t size) const
+{
+  if (size <= mapped_size_)
+    return;
+  unmap();
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file_, 0);
+  if (mapping == MAP_FAILED)
+    DUNE_THROW(IOError, "could not map '" << filename_ << "' (" << std::strerror(errno) << ")!");
+  mapping_ = static_cast< const char* >(mapping);
+  mapped_size_ = size;
+} // ... map(...)
+
+void AppendOnlyStore::unmap() const
+{
+  if (mapping_ != nullptr)
+    ::munmap(const_cast< char* >(mapping_), mapped_size_);
+  mapping_ = nullptr;
+  mapped_size_ = 0;
+} // ... unmap(...)
+
+
+} // namespace Pymor
+} // namespace Dune
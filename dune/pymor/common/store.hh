@@ -0,0 +1,89 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_STORE_HH
+#define DUNE_PYMOR_COMMON_STORE_HH
+
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Computes the 64 bit FNV-1a hash of size bytes, which (unlike std::hash) is stable across platforms and runs.
+ */
+uint64_t stable_hash(const void* data, const size_t size, const uint64_t seed = 14695981039346656037ull);
+
+
+/**
+ * \brief A persistent, append-only key-value store in a single file, which is memory mapped for reading.
+ *
+ *        The file starts with a header containing the signature given on construction. Opening a file of an unknown
+ *        format throws, such a file is never modified. Opening a store with a different signature (i.e., written for
+ *        a different discretization) throws as well, unless overwrite is true: its contents are then discarded and
+ *        the file is started anew. Each record carries a checksum of its key and value; a truncated or corrupted
+ *        record (e.g., from a crash during an append) and everything after it is dropped on opening.
+ *
+ *        Values are only ever appended, a key stored again shadows its earlier value. Thread safe within one process,
+ *        the file must not be written by several processes at the same time.
+ */
+class AppendOnlyStore
+{
+public:
+  /**
+   * \throws IOError if filename is not a store, or a store with a different signature and overwrite is false
+   */
+  AppendOnlyStore(const std::string filename, const std::string signature, const bool overwrite = false);
+
+  ~AppendOnlyStore();
+
+  AppendOnlyStore(const AppendOnlyStore& other) = delete;
+
+  AppendOnlyStore& operator=(const AppendOnlyStore& other) = delete;
+
+  const std::string& filename() const;
+
+  size_t size() const;
+
+  bool contains(const std::string& key) const;
+
+  /**
+   * \brief Copies the value stored for key to ret, returns false (and leaves ret untouched) if key is not present.
+   */
+  bool get(const std::string& key, std::string& ret) const;
+
+  void put(const std::string& key, const std::string& value);
+
+private:
+  struct Location
+  {
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  void open(const std::string& signature, const bool overwrite);
+  void start_anew(const std::string& signature);
+  void scan();
+  void map(const uint64_t size) const;
+  void unmap() const;
+
+  const std::string filename_;
+  int file_;
+  uint64_t end_;
+  std::unordered_map< std::string, Location > index_;
+  mutable const char* mapping_;
+  mutable uint64_t mapped_size_;
+  mutable std::mutex mutex_;
+}; // class AppendOnlyStore
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_STORE_HH
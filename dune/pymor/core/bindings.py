@@ -207,6 +207,7 @@ def inject_lib_dune_stuff(module, config_h_filename):
                 'ScalarType': 'double'},
         template_parameters='double',
         provides_data=True)
+    module.add_container('std::vector< ' + CommonDenseVector + ' >', CommonDenseVector, 'list')
     if CONFIG_H['HAVE_EIGEN']:
         module, _ = dune.pymor.la.container.inject_VectorImplementation(
             module,
@@ -228,7 +229,8 @@ def inject_lib_dune_stuff(module, config_h_filename):
             Traits={'ThisType': EigenMappedDenseVector,
                     'ScalarType': 'double'},
             template_parameters='double',
-            provides_data=False)
+            provides_data=True,
+            maps_buffer=True)
     if CONFIG_H['HAVE_DUNE_ISTL']:
         module, _ = dune.pymor.la.container.inject_VectorImplementation(
             module,
@@ -288,6 +290,17 @@ def inject_lib_dune_pymor(module, config_h_filename):
      ) = dune.pymor.parameters.inject_Parametric(module, exceptions, CONFIG_H)
     (module, interfaces['Dune::Pymor::ParameterFunctional']
      ) = dune.pymor.parameters.inject_ParameterFunctional(module, exceptions, interfaces, CONFIG_H)
+    (module, interfaces['Dune::Pymor::ParameterSampler']
+     ) = dune.pymor.parameters.inject_ParameterSampler(module, exceptions, CONFIG_H)
+    # the multi vector, which all operators and discretizations return
+    (module, interfaces['Dune::Pymor::Tags::MultiVectorInterface']
+            ) = inject_Class(module, 'Dune::Pymor::Tags::MultiVectorInterface')
+    VectorTypes = [CommonDenseVector]
+    if CONFIG_H['HAVE_EIGEN']:
+        VectorTypes += [EigenDenseVector, EigenMappedDenseVector]
+    if CONFIG_H['HAVE_DUNE_ISTL']:
+        VectorTypes += [IstlDenseVector]
+    module, _ = dune.pymor.la.container.inject_MultiVector(module, exceptions, interfaces, CONFIG_H, VectorTypes)
     # next we add what we need of the functionals
     (module, interfaces['Dune::Pymor::Tags::FunctionalInterface']
             ) = inject_Class(module, 'Dune::Pymor::Tags::FunctionalInterface')
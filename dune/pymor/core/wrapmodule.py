@@ -7,7 +7,7 @@ from inspect import isclass
 from types import ModuleType
 
 from dune.pymor.core.wrapper import DuneStuffWrapper, Wrapper
-from dune.pymor.la.container import wrap_vector
+from dune.pymor.la.container import wrap_vector, wrap_multi_vector
 from dune.pymor.discretizations import wrap_stationary_discretization
 try:
     from dune.pymor.discretizations import wrap_multiscale_discretization
@@ -83,6 +83,7 @@ def wrap_module(mod):
     AffinelyDecomposedOperatorInterface = mod.Dune.Pymor.Tags.AffinelyDecomposedOperatorInterface
     FunctionalInterface = mod.Dune.Pymor.Tags.FunctionalInterface
     VectorInterface = mod.Dune.Stuff.LA.Tags.VectorInterface
+    MultiVectorInterface = mod.Dune.Pymor.Tags.MultiVectorInterface
     OperatorInterface = mod.Dune.Pymor.Tags.OperatorInterface
     Parameter = mod.Dune.Pymor.Parameter
     ParameterFunctional = mod.Dune.Pymor.ParameterFunctional
@@ -133,6 +134,12 @@ def wrap_module(mod):
                 wrapped_vector = wrap_vector(v)
                 add_to_module(k, wrapped_vector, mod)
                 wrapper.add_vector_class(v, wrapped_vector)
+            elif v == MultiVectorInterface:
+                continue
+            elif isclass(v) and issubclass(v, MultiVectorInterface):
+                wrapped_array = wrap_multi_vector(v)
+                add_to_module(k, wrapped_array, mod)
+                wrapper.add_multi_vector_class(v, wrapped_array)
 
     def wrap_classes(mod):
         for k, v in mod.__dict__.iteritems():
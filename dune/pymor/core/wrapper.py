@@ -6,7 +6,6 @@
 from __future__ import absolute_import, division, print_function
 
 from inspect import isclass
-from itertools import izip
 from types import ModuleType
 
 import numpy as np
@@ -50,6 +49,8 @@ class Wrapper(object):
         self.wrapped_classes_by_type_this = {}
         self.DuneParameterType = DuneParameterType
         self.DuneParameter = DuneParameter
+        self.multi_vector_class = None
+        self._dune_parameter_prototypes = {}
         self.instance_wrappers = {DuneParameterType: self._parameter_type,
                                   DuneParameter: self._parameter,
                                   DuneParameterFunctional: self._parameter_functional}
@@ -66,14 +67,20 @@ class Wrapper(object):
     def add_vector_class(self, cls, wrapped_cls):
         self.add_class(cls, wrapped_cls)
 
+    def add_multi_vector_class(self, cls, wrapped_cls):
+        # not added to wrapped_classes, since the wrapped arrays additionally need to know their vector type
+        self.multi_vector_class = wrapped_cls
+
     def _parameter_type(self, dune_parameter_type):
-        return ParameterType({k: v for k, v in izip(list(dune_parameter_type.keys()),
-                                                    list(dune_parameter_type.values()))})
+        return ParameterType(dict(zip(dune_parameter_type.keys(), dune_parameter_type.values())))
 
     def _parameter(self, dune_parameter):
         assert isinstance(dune_parameter, self.DuneParameter)
-        return Parameter({k: np.array(v) for k, v in izip(list(dune_parameter.keys()),
-                                                          [list(p) for p in list(dune_parameter.values())])})
+        # a single serialize() instead of one list per key, the keys are sorted as in serialize()
+        dune_parameter_type = dune_parameter.type()
+        keys, sizes = list(dune_parameter_type.keys()), list(dune_parameter_type.values())
+        values = np.split(np.array(dune_parameter.serialize()), np.cumsum(sizes)[:-1]) if keys else []
+        return Parameter(dict(zip(keys, values)))
 
     def _parameter_functional(self, dune_functional):
         pt = self[dune_functional.parameter_type()]
@@ -82,10 +89,23 @@ class Wrapper(object):
 
     def dune_parameter(self, parameter):
         assert isinstance(parameter, Parameter)
-        dune_parameter = self.DuneParameter()
-        for k, v in parameter.iteritems():
-            assert v.ndim == 1
-            dune_parameter.set(k, list(v))
+        if not parameter:
+            return self.DuneParameter()
+        # the prototypes are cached by the (unsorted) keys and shapes, such that the keys are only sorted (as in the
+        # C++ Parameter, to set its values by a single deserialize()) once per parameter type
+        parameter_type = tuple((k, v.shape) for k, v in parameter.iteritems())
+        try:
+            keys, prototype = self._dune_parameter_prototypes[parameter_type]
+        except KeyError:
+            prototype = self.DuneParameter()
+            for k, shape in parameter_type:
+                assert len(shape) == 1
+                prototype.set(k, [0.] * shape[0])
+            keys = sorted(k for k, _ in parameter_type)
+            self._dune_parameter_prototypes[parameter_type] = (keys, prototype)
+        dune_parameter = self.DuneParameter(prototype)
+        # deserialize() reads the contiguous array via the buffer protocol, without converting it to a list
+        dune_parameter.deserialize(np.concatenate([parameter[k] for k in keys]).astype(np.float64, copy=False))
         return dune_parameter
 
     def __getitem__(self, obj):
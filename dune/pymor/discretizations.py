@@ -11,11 +11,10 @@ import pybindgen
 from pybindgen import retval, param
 import numpy as np
 
-from dune.pymor.la.container import make_listvectorarray
+from dune.pymor.la.container import multi_vector_type
 
 from pymor.discretizations.interfaces import DiscretizationInterface
 from pymor.discretizations.basic import StationaryDiscretization
-from pymor.vectorarrays.list import ListVectorArray
 from pymor.vectorarrays.numpy import NumpyVectorArray
 from pymor.operators.constructions import VectorOperator, induced_norm
 from pymor.tools.frozendict import FrozenDict
@@ -127,52 +126,64 @@ def inject_StationaryDiscretizationImplementation(module, exceptions, interfaces
                      [param('const std::string&', 'type'),
                       param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param('const Dune::Stuff::Common::Configuration&', 'options'),
                       param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param(VectorType + ' &', 'vector')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('const std::string&', 'type'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('const Dune::Stuff::Common::Configuration&', 'options'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
-                     [], is_const=True, throw=exceptions)
+                     [], is_const=True, throw=exceptions, unblock_threads=True)
+    Class.add_method('solve_many',
+                     retval('std::vector< ' + VectorType + ' >'),
+                     [param('const Dune::Stuff::Common::Configuration', 'options'),
+                      param('const std::vector< Dune::Pymor::Parameter > &', 'mus'),
+                      param('const size_t', 'num_threads')],
+                     is_const=True, throw=exceptions, unblock_threads=True)
+    Class.add_method('solve_multi',
+                     retval(multi_vector_type('double')),
+                     [param('const Dune::Stuff::Common::Configuration', 'options'),
+                      param('const std::vector< Dune::Pymor::Parameter > &', 'mus'),
+                      param('const size_t', 'num_threads')],
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('visualize',
                      None,
                      [param('const ' + VectorType + ' &', 'vector'),
                       param('const std::string', 'filename'),
                       param('const std::string', 'name')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('visualize',
                      None,
                      [param('const ' + VectorType + ' &', 'vector'),
                       param('const std::string', 'filename'),
                       param('const std::string', 'name'),
                       param('const bool', 'add_dirichlet')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     return Class
 
 
@@ -193,7 +204,8 @@ def wrap_stationary_discretization(cls, wrapper):
             self._impl = d
             operators = {'operator': wrap_op(d.get_operator())}
             functionals = {'rhs': self._wrapper[d.get_rhs()]}
-            vector_operators = FrozenDict({k: VectorOperator(make_listvectorarray(self._wrapper[d.get_vector(k)]))
+            array_type = self._wrapper.multi_vector_class
+            vector_operators = FrozenDict({k: VectorOperator(array_type.from_vectors([self._wrapper[d.get_vector(k)]]))
                                            for k in list(d.available_vectors())})
             self.operators = FrozenDict(operators)
             self.functionals = FrozenDict(functionals)
@@ -252,20 +264,27 @@ def wrap_stationary_discretization(cls, wrapper):
             if not self.logging_disabled:
                 self.logger.info('Solving {} for {} ...'.format(self.name, mu))
             mu = self._wrapper.dune_parameter(mu)
-            solution = self._impl.solve_and_return_ptr(self.solver_options, mu)
-            assert solution.valid()
-            solution = self._wrapper[solution]
-            return ListVectorArray([solution])
+            solution = self._impl.solve_multi(self.solver_options, [mu], 1)
+            return self.solution_space.type(solution, self.solution_space.subtype[0])
 
         _solve = solve
 
+        def solve_many(self, mus, num_threads=0):
+            mus = [self.parse_parameter(mu) for mu in mus]
+            if not self.logging_disabled:
+                self.logger.info('Solving {} for {} parameters ...'.format(self.name, len(mus)))
+            solutions = self._impl.solve_multi(self.solver_options,
+                                               [self._wrapper.dune_parameter(mu) for mu in mus],
+                                               num_threads)
+            return self.solution_space.type(solutions, self.solution_space.subtype[0])
+
         def visualize(self, U, file_name=None, name='solution', delete=True):
             assert len(U) == 1
             if file_name is None:
                 _, file_name = mkstemp(suffix='.vtu')
             if not file_name.endswith('.vtu'):
                 file_name = file_name + '.vtu'
-            self._impl.visualize(U._list[0]._impl, file_name[:-4], name)
+            self._impl.visualize(U.vector(0)._impl, file_name[:-4], name)
             subprocess.call(['paraview', file_name])
             if delete:
                 os.remove(file_name)
@@ -416,7 +435,7 @@ if BLOCK_OPERATOR_PRESENT:
                 mu = self._wrapper.dune_parameter(mu)
                 global_solution = self._impl.solve_and_return_ptr(mu)
                 assert global_solution.valid()
-                global_solution = make_listvectorarray(self._wrapper[global_solution])
+                global_solution = self._wrapper.multi_vector_class.from_vectors([self._wrapper[global_solution]])
                 return BlockVectorArray([self.localize_vector(global_solution, ss)
                                          for ss in np.arange(self._impl.num_subdomains())])
 
@@ -429,21 +448,22 @@ if BLOCK_OPERATOR_PRESENT:
                     _, file_name = mkstemp(suffix='.vtu')
                 if not file_name.endswith('.vtu'):
                     file_name = file_name + '.vtu'
-                self._impl.visualize(U._list[0]._impl, file_name[:-4], name)
+                self._impl.visualize(U.vector(0)._impl, file_name[:-4], name)
                 subprocess.call(['paraview', file_name])
                 if delete:
                     os.remove(file_name)
 
             def localize_vector(self, global_vector, subdomain):
                 assert subdomain < self.num_subdomains
-                return make_listvectorarray([self._wrapper[self._impl.localize_vector(global_vector._list[ii]._impl,
-                                                                                      subdomain)]
-                                             for ii in np.arange(len(global_vector))])
+                return self._wrapper.multi_vector_class.from_vectors(
+                    [self._wrapper[self._impl.localize_vector(global_vector.vector(ii)._impl, subdomain)]
+                     for ii in np.arange(len(global_vector))])
             def globalize_vectors(self, local_vectors):
                 assert isinstance(local_vectors, BlockVectorArray)
-                return ListVectorArray([self._wrapper[self._impl.globalize_vectors([block._list[ii]._impl
-                                                                                    for block in local_vectors._blocks])]
-                                        for ii in np.arange(len(local_vectors))])
+                return self._wrapper.multi_vector_class.from_vectors(
+                    [self._wrapper[self._impl.globalize_vectors([block.vector(ii)._impl
+                                                                 for block in local_vectors._blocks])]
+                     for ii in np.arange(len(local_vectors))])
 
             def local_product(self, subdomain, id):
                 assert subdomain < self.num_subdomains
@@ -6,10 +6,17 @@
 #ifndef DUNE_PYMOR_DISCRETIZATIONS_DEFAULT_HH
 #define DUNE_PYMOR_DISCRETIZATIONS_DEFAULT_HH
 
-#include <map>
+#include <string>
+#include <memory>
+#include <cstring>
+#include <sstream>
+#include <utility>
 
 #include <dune/stuff/common/crtp.hh>
 
+#include <dune/pymor/common/cache.hh>
+#include <dune/pymor/common/store.hh>
+
 #include "interfaces.hh"
 
 namespace Dune {
@@ -17,6 +24,15 @@ namespace Pymor {
 namespace StationaryDiscretization {
 
 
+/**
+ * \brief Caches the solutions of uncached_solve() for each parameter and each set of solver options.
+ *
+ *        Derived classes have to implement uncached_solve(options, vector, mu). All solves of the interface (including
+ *        solve_many(), solve_multi() and compute_snapshots()) go through the cache. The cache is thread safe and
+ *        bounded by a memory budget (unbounded by default), once the budget is exhausted the least recently (or least
+ *        frequently, see set_cache_policy()) used solutions are evicted. The cache is shared by all copies of this
+ *        discretization. Optionally, all solutions are also kept on disk, see enable_disk_cache().
+ */
 template< class Traits >
 class CachingDefault
   : public StationaryDiscretizationInterface< Traits >
@@ -26,34 +42,192 @@ public:
   typedef typename Traits::derived_type derived_type;
   typedef typename Traits::VectorType   VectorType;
 
+  typedef typename BaseType::MultiVectorType MultiVectorType;
+
+private:
+  //! the parameter and the report of the solver options
+  typedef std::pair< FlatParameter, std::string > CacheKeyType;
+
+  struct CacheKeyHash
+  {
+    size_t operator()(const CacheKeyType& key) const
+    {
+      return std::hash< FlatParameter >()(key.first) ^ (std::hash< std::string >()(key.second) << 1);
+    }
+  };
+
+  typedef ShardedCache< CacheKeyType, VectorType, CacheKeyHash > CacheType;
+
+public:
   CachingDefault(const ParameterType tt = ParameterType())
     : BaseType(tt)
+    , cache_(std::make_shared< CacheType >())
   {}
 
   CachingDefault(const Parametric& other)
     : BaseType(other)
+    , cache_(std::make_shared< CacheType >())
   {}
 
-  void solve(VectorType& vector, const Parameter mu = Parameter()) const
+  void solve(const DSC::Configuration options, VectorType& vector, const Parameter mu = Parameter()) const
   {
-    const auto search_result = cache_.find(mu);
-    if (search_result == cache_.end()) {
-      uncached_solve(vector, mu);
-      cache_.insert(std::make_pair(mu, std::shared_ptr< VectorType >(new VectorType(vector.copy()))));
-    } else {
-      const auto& result = *(search_result->second);
-      vector = result;
+    const CacheKeyType key(FlatParameter(mu), options_key(options));
+    const auto result = cache_->get(key);
+    if (result) {
+      // the vectors are copy on write, so this does not copy any data
+      vector = *result;
+      return;
     }
+    solve_and_insert(key, options, vector, mu);
   } // ... solve(...)
 
+  using BaseType::solve;
+
+  /**
+   * \brief Copies a cached solution to vectors directly, solves into tmp otherwise (see solve_multi()).
+   */
+  void solve_into(const DSC::Configuration& options,
+                  const Parameter& mu,
+                  MultiVectorType& vectors,
+                  const size_t ii,
+                  VectorType& tmp) const
+  {
+    const CacheKeyType key(FlatParameter(mu), options_key(options));
+    const auto result = cache_->get(key);
+    if (result) {
+      vectors.set(ii, *result);
+      return;
+    }
+    solve_and_insert(key, options, tmp, mu);
+    vectors.set(ii, tmp);
+  } // ... solve_into(...)
+
+  /**
+   * \brief Additionally keeps all solutions in the given file, such that they survive the process.
+   *
+   *        The signature has to identify the discretization (e.g., its type, grid and dimensions). If filename holds
+   *        solutions stored under a different signature, this throws, unless overwrite is true, in which case they are
+   *        discarded. A file which is not a store at all is never touched. solve() looks up the file before calling
+   *        uncached_solve() and appends each new solution to it.
+   * \see   AppendOnlyStore
+   */
+  void enable_disk_cache(const std::string filename, const std::string signature, const bool overwrite = false)
+  {
+    std::atomic_store(&store_, std::make_shared< AppendOnlyStore >(filename, signature, overwrite));
+  }
+
+  void disable_disk_cache()
+  {
+    std::atomic_store(&store_, std::shared_ptr< AppendOnlyStore >());
+  }
+
+  bool has_disk_cache() const
+  {
+    return bool(std::atomic_load(&store_));
+  }
+
+  /**
+   * \brief Limits the memory held by the cached solutions, in bytes.
+   */
+  void set_cache_budget(const size_t bytes)
+  {
+    cache_->set_budget(bytes);
+  }
+
+  size_t cache_budget() const
+  {
+    return cache_->budget();
+  }
+
+  void set_cache_policy(const EvictionPolicy policy)
+  {
+    cache_->set_policy(policy);
+  }
+
+  EvictionPolicy cache_policy() const
+  {
+    return cache_->policy();
+  }
+
+  CacheStatistics cache_statistics() const
+  {
+    return cache_->statistics();
+  }
+
+  void clear_cache()
+  {
+    cache_->clear();
+  }
+
 protected:
-  void uncached_solve(VectorType& vector, const Parameter mu = Parameter()) const
+  void uncached_solve(const DSC::Configuration options, VectorType& vector, const Parameter mu = Parameter()) const
   {
-    CHECK_AND_CALL_CRTP(this->as_imp(*this).uncached_solve(vector, mu));
+    CHECK_AND_CALL_CRTP(this->as_imp(*this).uncached_solve(options, vector, mu));
   }
 
 private:
-  mutable std::map< Parameter, std::shared_ptr< VectorType > > cache_;
+  typedef typename VectorType::ScalarType ScalarType;
+
+  static std::string options_key(const DSC::Configuration& options)
+  {
+    std::ostringstream ret;
+    options.report(ret);
+    return ret.str();
+  }
+
+  void solve_and_insert(const CacheKeyType& key,
+                        const DSC::Configuration& options,
+                        VectorType& vector,
+                        const Parameter& mu) const
+  {
+    // solve() may run concurrently with enable_disk_cache() (e.g., from python threads, which do not hold the GIL)
+    const auto store = std::atomic_load(&store_);
+    const std::string stored_key = store ? store_key(mu, key.second) : std::string();
+    if (!(store && load(*store, stored_key, vector))) {
+      uncached_solve(options, vector, mu);
+      if (store)
+        save(*store, stored_key, vector);
+    }
+    cache_->insert(key,
+                   std::make_shared< const VectorType >(vector.copy()),
+                   vector.size() * sizeof(ScalarType));
+  } // ... solve_and_insert(...)
+
+  static std::string store_key(const Parameter& mu, const std::string& options)
+  {
+    const auto values = mu.serialize();
+    return mu.type().report_for_filename() + '\0' + options + '\0'
+        + std::string(reinterpret_cast< const char* >(values.data()), values.size() * sizeof(double));
+  }
+
+  static bool load(const AppendOnlyStore& store, const std::string& key, VectorType& vector)
+  {
+    std::string data;
+    if (!store.get(key, data))
+      return false;
+    // reject anything not matching this discretization
+    if (data.size() != vector.size() * sizeof(ScalarType))
+      return false;
+    for (size_t ii = 0; ii < vector.size(); ++ii) {
+      ScalarType value;
+      std::memcpy(&value, data.data() + ii * sizeof(ScalarType), sizeof(ScalarType));
+      vector.set_entry(ii, value);
+    }
+    return true;
+  } // ... load(...)
+
+  static void save(AppendOnlyStore& store, const std::string& key, const VectorType& vector)
+  {
+    std::string data(vector.size() * sizeof(ScalarType), '\0');
+    for (size_t ii = 0; ii < vector.size(); ++ii) {
+      const ScalarType value = vector.get_entry(ii);
+      std::memcpy(&data[ii * sizeof(ScalarType)], &value, sizeof(ScalarType));
+    }
+    store.put(key, data);
+  } // ... save(...)
+
+  std::shared_ptr< CacheType > cache_;
+  std::shared_ptr< AppendOnlyStore > store_;
 }; // class CachingDefault
 
 
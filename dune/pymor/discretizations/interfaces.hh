@@ -8,16 +8,20 @@
 
 #include <vector>
 #include <string>
+#include <chrono>
+#include <algorithm>
 
 #include <dune/stuff/common/crtp.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/parallel.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/operators/interfaces.hh>
 #include <dune/pymor/functionals/interfaces.hh>
 #include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/la/container/multivector.hh>
 
 namespace Dune {
 namespace Pymor {
@@ -45,7 +49,8 @@ public:
   typedef typename Traits::ProductType    ProductType;
   typedef typename Traits::VectorType     VectorType;
 
-  typedef Pymor::LA::AffinelyDecomposedContainer< VectorType > AffinelyDecomposedVectorType;
+  typedef Pymor::LA::AffinelyDecomposedContainer< VectorType >         AffinelyDecomposedVectorType;
+  typedef Pymor::LA::MultiVector< typename VectorType::ScalarType > MultiVectorType;
 
   StationaryDiscretizationInterface(const ParameterType tt = ParameterType())
     : Parametric(tt)
@@ -154,6 +159,105 @@ public:
     return ret;
   }
 
+  /**
+   * \brief Solves for each of mus in parallel, vectors[ii] is the solution for mus[ii].
+   *
+   *        The parameters are handed out one by one to num_threads threads (all hardware threads if 0), each of which
+   *        calls solve() and thus freezes and inverts the operator on its own; solve() has to be thread safe. vectors
+   *        has to be preallocated (e.g., by create_vector()). If timings is not null, (*timings)[ii] is set to the wall
+   *        time (in seconds) of the solve for mus[ii].
+   */
+  void solve_many(const DSC::Configuration options,
+                  const std::vector< Parameter >& mus,
+                  std::vector< VectorType >& vectors,
+                  std::vector< double >* timings = nullptr,
+                  const size_t num_threads = 0) const
+  {
+    if (vectors.size() != mus.size())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of vectors (" << vectors.size() << ") does not match the size of mus (" << mus.size()
+                 << ")!");
+    if (timings)
+      timings->resize(mus.size());
+    parallel_for(mus.size(),
+                 [&](const size_t ii, const size_t /*thread*/) {
+                   const auto start = std::chrono::steady_clock::now();
+                   solve(options, vectors[ii], mus[ii]);
+                   if (timings)
+                     (*timings)[ii] = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+                 },
+                 num_threads);
+  } // ... solve_many(...)
+
+  std::vector< VectorType > solve_many(const DSC::Configuration options,
+                                       const std::vector< Parameter >& mus,
+                                       const size_t num_threads = 0) const
+  {
+    std::vector< VectorType > ret;
+    ret.reserve(mus.size());
+    for (size_t ii = 0; ii < mus.size(); ++ii)
+      ret.emplace_back(create_vector());
+    solve_many(options, mus, ret, nullptr, num_threads);
+    return ret;
+  }
+
+  std::vector< VectorType > solve_many(const std::vector< Parameter >& mus, const size_t num_threads = 0) const
+  {
+    return solve_many(solver_options(), mus, num_threads);
+  }
+
+  std::vector< VectorType > solve_many(const std::string type,
+                                       const std::vector< Parameter >& mus,
+                                       const size_t num_threads = 0) const
+  {
+    return solve_many(solver_options(type), mus, num_threads);
+  }
+
+  /**
+   * \brief Solves for each of mus in parallel (see above), the vector ii of the result is the solution for mus[ii].
+   *
+   *        Each solution is stored into the result by solve_into(), each thread reuses one vector to solve into.
+   */
+  MultiVectorType solve_multi(const DSC::Configuration options,
+                              const std::vector< Parameter >& mus,
+                              const size_t num_threads = 0) const
+  {
+    const size_t threads = std::max(std::min(num_threads == 0 ? default_num_threads() : num_threads, mus.size()),
+                                    size_t(1));
+    std::vector< VectorType > vectors;
+    vectors.reserve(threads);
+    for (size_t tt = 0; tt < threads; ++tt)
+      vectors.emplace_back(create_vector());
+    MultiVectorType ret(vectors[0].size(), mus.size());
+    parallel_for(mus.size(),
+                 [&](const size_t ii, const size_t thread) {
+                   this->as_imp().solve_into(options, mus[ii], ret, ii, vectors[thread]);
+                 },
+                 threads);
+    return ret;
+  } // ... solve_multi(...)
+
+  /**
+   * \brief Stores the solution for mu as the vector ii of vectors, solving into tmp.
+   *
+   *        Used by solve_multi(). Derived classes which may already hold the solution (e.g., in a cache) may shadow
+   *        this and copy it to vectors without going through tmp.
+   */
+  void solve_into(const DSC::Configuration& options,
+                  const Parameter& mu,
+                  MultiVectorType& vectors,
+                  const size_t ii,
+                  VectorType& tmp) const
+  {
+    solve(options, tmp, mu);
+    vectors.set(ii, tmp);
+  }
+
+  MultiVectorType solve_multi(const std::vector< Parameter >& mus, const size_t num_threads = 0) const
+  {
+    return solve_multi(solver_options(), mus, num_threads);
+  }
+
   void visualize(const VectorType& vector, const std::string filename, const std::string name) const
   {
     CHECK_AND_CALL_CRTP(this->as_imp().visualize(vector, filename, name));
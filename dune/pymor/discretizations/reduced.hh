@@ -0,0 +1,319 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_DISCRETIZATIONS_REDUCED_HH
+#define DUNE_PYMOR_DISCRETIZATIONS_REDUCED_HH
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <memory>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/string.hh>
+#include <dune/stuff/la/container.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace StationaryDiscretization {
+namespace internal {
+
+
+/**
+ * \brief Storage of size entries, on the stack (inside the owning object) for fixed_size > 0, on the heap otherwise.
+ */
+template< class ScalarType, size_t fixed_size >
+class DenseBuffer
+{
+public:
+  explicit DenseBuffer(const size_t /*size*/) {}
+
+  ScalarType* data() { return values_.data(); }
+
+  const ScalarType* data() const { return values_.data(); }
+
+private:
+  std::array< ScalarType, fixed_size > values_;
+}; // class DenseBuffer
+
+
+template< class ScalarType >
+class DenseBuffer< ScalarType, 0 >
+{
+public:
+  explicit DenseBuffer(const size_t size) : values_(size) {}
+
+  ScalarType* data() { return values_.data(); }
+
+  const ScalarType* data() const { return values_.data(); }
+
+private:
+  std::vector< ScalarType > values_;
+}; // class DenseBuffer< ..., 0 >
+
+
+/**
+ * \brief Solves the row-major n x n system matrix * x = rhs in place by an LU decomposition with partial pivoting.
+ *
+ *        matrix is overwritten by its factors and rhs by the solution. For N > 0 all loop bounds are compile-time
+ *        constants (n has to equal N then), which allows the compiler to unroll and vectorize the loops.
+ * \return false, if the matrix is singular
+ */
+template< size_t N, class ScalarType >
+bool dense_lu_solve(const size_t size, ScalarType* matrix, ScalarType* rhs)
+{
+  const size_t n = (N > 0) ? N : size;
+  for (size_t kk = 0; kk < n; ++kk) {
+    size_t pivot = kk;
+    ScalarType pivot_value = std::abs(matrix[kk * n + kk]);
+    for (size_t ii = kk + 1; ii < n; ++ii) {
+      const ScalarType value = std::abs(matrix[ii * n + kk]);
+      if (value > pivot_value) {
+        pivot = ii;
+        pivot_value = value;
+      }
+    }
+    if (!(pivot_value > ScalarType(0)))
+      return false;
+    if (pivot != kk) {
+      for (size_t jj = 0; jj < n; ++jj)
+        std::swap(matrix[kk * n + jj], matrix[pivot * n + jj]);
+      std::swap(rhs[kk], rhs[pivot]);
+    }
+    const ScalarType inverse_diagonal = ScalarType(1) / matrix[kk * n + kk];
+    for (size_t ii = kk + 1; ii < n; ++ii) {
+      const ScalarType factor = matrix[ii * n + kk] * inverse_diagonal;
+      for (size_t jj = kk + 1; jj < n; ++jj)
+        matrix[ii * n + jj] -= factor * matrix[kk * n + jj];
+      rhs[ii] -= factor * rhs[kk];
+    }
+  }
+  for (size_t ii = n; ii > 0; --ii) {
+    const size_t row = ii - 1;
+    ScalarType value = rhs[row];
+    for (size_t jj = row + 1; jj < n; ++jj)
+      value -= matrix[row * n + jj] * rhs[jj];
+    rhs[row] = value / matrix[row * n + row];
+  }
+  return true;
+} // ... dense_lu_solve(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief The online phase of a reduced basis method: a small dense, affinely decomposed system A(mu) u = f(mu).
+ *
+ *        All components are copied into contiguous storage on construction. solve() evaluates the coefficients,
+ *        assembles the system into preallocated buffers and solves it by an LU decomposition without allocating any
+ *        memory (apart from solve(const Parameter&, ...), which has to serialize mu). If the size of the reduced basis
+ *        is known at compile time, pass it as N: all buffers are then part of the object and the decomposition is
+ *        unrolled for this size. Since the buffers are members, one object must not be used from several threads at
+ *        the same time, use one copy per thread instead.
+ *
+ *        The reduced components are typically obtained by Reductors::Projection.
+ */
+template< class ScalarImp = double, size_t N = 0 >
+class ReducedDense
+  : public Parametric
+{
+public:
+  typedef ScalarImp                                  ScalarType;
+  typedef Stuff::LA::CommonDenseMatrix< ScalarType > MatrixType;
+  typedef Stuff::LA::CommonDenseVector< ScalarType > VectorType;
+
+  static std::string static_id() { return "pymor.discretizations.reduceddense"; }
+
+  ReducedDense(const LA::AffinelyDecomposedConstContainer< MatrixType >& op,
+               const LA::AffinelyDecomposedConstContainer< VectorType >& rhs)
+    : size_(op.has_affine_part() ? op.affine_part()->rows() : op.component(0)->rows())
+    , op_affine_(op.has_affine_part())
+    , rhs_affine_(rhs.has_affine_part())
+    , matrix_(size_ * size_)
+    , rhs_(size_)
+  {
+    if (N > 0 && size_ != N)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of the reduced system (" << size_ << ") does not match the fixed size " << N << "!");
+    if (op_affine_)
+      append(*op.affine_part(), op_components_);
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < op.num_components(); ++qq) {
+      append(*op.component(qq), op_components_);
+      op_coefficients_.push_back(op.coefficient(qq));
+      op_projections_.push_back(inherit_parameter_type(op.coefficient(qq)->parameter_type(),
+                                                       "operator_coefficient_" + Stuff::Common::toString(qq)));
+    }
+    if (rhs_affine_)
+      append(*rhs.affine_part(), rhs_components_);
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < rhs.num_components(); ++qq) {
+      append(*rhs.component(qq), rhs_components_);
+      rhs_coefficients_.push_back(rhs.coefficient(qq));
+      rhs_projections_.push_back(inherit_parameter_type(rhs.coefficient(qq)->parameter_type(),
+                                                        "rhs_coefficient_" + Stuff::Common::toString(qq)));
+    }
+    if (op_components_.empty() || rhs_components_.empty())
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met, "op and rhs must not be empty!");
+    if (op_components_.size() % (size_ * size_) != 0 || rhs_components_.size() % size_ != 0)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match, "the shapes of op and rhs do not match!");
+    size_t scratch_size = 0;
+    for (const auto& coefficient : op_coefficients_)
+      scratch_size = std::max(scratch_size, coefficient->parameter_type().layout()->dim());
+    for (const auto& coefficient : rhs_coefficients_)
+      scratch_size = std::max(scratch_size, coefficient->parameter_type().layout()->dim());
+    scratch_.resize(scratch_size);
+    op_thetas_.resize(op_coefficients_.size() + (op_affine_ ? 1 : 0), 1.);
+    rhs_thetas_.resize(rhs_coefficients_.size() + (rhs_affine_ ? 1 : 0), 1.);
+  } // ReducedDense(...)
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  /**
+   * \brief Solves for the serialized parameter mu (of parameter_type()), solution has to provide size() entries.
+   */
+  void solve(const double* mu, const size_t mu_size, ScalarType* solution) const
+  {
+    if (mu_size != parameter_type().layout()->dim())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "mu has " << mu_size << " entries, the parameter_type of this requires "
+                 << parameter_type().layout()->dim() << "!");
+    evaluate(mu, op_coefficients_, op_projections_, op_affine_, op_thetas_);
+    evaluate(mu, rhs_coefficients_, rhs_projections_, rhs_affine_, rhs_thetas_);
+    assemble(op_components_.data(), op_thetas_, size_ * size_, matrix_.data());
+    assemble(rhs_components_.data(), rhs_thetas_, size_, rhs_.data());
+    if (!internal::dense_lu_solve< N >(size_, matrix_.data(), rhs_.data()))
+      DUNE_THROW(Stuff::Exceptions::linear_solver_failed, "the reduced system is singular!");
+    std::copy(rhs_.data(), rhs_.data() + size_, solution);
+  } // ... solve(...)
+
+  void solve(const FlatParameter& mu, ScalarType* solution) const
+  {
+    if (!mu.has_type(parameter_type()))
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.parameter().type() << ") does not match the parameter_type of this ("
+                 << parameter_type() << ")!");
+    solve(mu.data(), mu.size(), solution);
+  }
+
+  /**
+   * \brief Solves for mu, solution is only resized if it does not provide size() entries.
+   */
+  void solve(const FlatParameter& mu, VectorType& solution) const
+  {
+    if (solution.size() != size_)
+      solution = VectorType(size_);
+    solve(mu, &(solution.backend()[0]));
+  }
+
+  void solve(const Parameter& mu, VectorType& solution) const
+  {
+    if (mu.type() != parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                 << parameter_type() << ")!");
+    const auto serialized_mu = mu.serialize();
+    if (solution.size() != size_)
+      solution = VectorType(size_);
+    solve(serialized_mu.data(), serialized_mu.size(), &(solution.backend()[0]));
+  } // ... solve(...)
+
+  VectorType solve(const Parameter& mu = Parameter()) const
+  {
+    VectorType solution(size_);
+    solve(mu, solution);
+    return solution;
+  }
+
+private:
+  template< class ContainerType >
+  void append(const ContainerType& container, std::vector< ScalarType >& target) const
+  {
+    append_entries(container, target, std::is_base_of< Stuff::LA::Tags::VectorInterface, ContainerType >());
+  }
+
+  void append_entries(const MatrixType& matrix, std::vector< ScalarType >& target, std::false_type) const
+  {
+    if (matrix.rows() != size_ || matrix.cols() != size_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "all components of op have to be " << size_ << "x" << size_ << " (are " << matrix.rows() << "x"
+                 << matrix.cols() << ")!");
+    for (size_t ii = 0; ii < size_; ++ii)
+      for (size_t jj = 0; jj < size_; ++jj)
+        target.push_back(matrix.get_entry(ii, jj));
+  }
+
+  void append_entries(const VectorType& vector, std::vector< ScalarType >& target, std::true_type) const
+  {
+    if (vector.size() != size_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "all components of rhs have to be of size " << size_ << " (are " << vector.size() << ")!");
+    for (size_t ii = 0; ii < size_; ++ii)
+      target.push_back(vector.get_entry(ii));
+  }
+
+  void evaluate(const double* mu,
+                const std::vector< std::shared_ptr< const ParameterFunctional > >& coefficients,
+                const std::vector< size_t >& projections,
+                const bool affine,
+                std::vector< double >& thetas) const
+  {
+    // thetas[0] stays 1 for the affine part
+    const size_t offset = affine ? 1 : 0;
+    for (size_t qq = 0; qq < coefficients.size(); ++qq) {
+      const auto& projection = parameter_projection(projections[qq]);
+      thetas[offset + qq] = coefficients[qq]->evaluate(projection.map(mu, scratch_.data()), projection.dim());
+    }
+  } // ... evaluate(...)
+
+  static void assemble(const ScalarType* components,
+                       const std::vector< double >& thetas,
+                       const size_t size,
+                       ScalarType* target)
+  {
+    const ScalarType first_theta = thetas[0];
+    for (size_t ii = 0; ii < size; ++ii)
+      target[ii] = first_theta * components[ii];
+    for (size_t qq = 1; qq < thetas.size(); ++qq) {
+      const ScalarType* component = components + qq * size;
+      const ScalarType theta = thetas[qq];
+      for (size_t ii = 0; ii < size; ++ii)
+        target[ii] += theta * component[ii];
+    }
+  } // ... assemble(...)
+
+  size_t size_;
+  bool op_affine_;
+  bool rhs_affine_;
+  std::vector< ScalarType > op_components_;
+  std::vector< ScalarType > rhs_components_;
+  std::vector< std::shared_ptr< const ParameterFunctional > > op_coefficients_;
+  std::vector< std::shared_ptr< const ParameterFunctional > > rhs_coefficients_;
+  std::vector< size_t > op_projections_;
+  std::vector< size_t > rhs_projections_;
+  mutable std::vector< double > scratch_;
+  mutable std::vector< double > op_thetas_;
+  mutable std::vector< double > rhs_thetas_;
+  mutable internal::DenseBuffer< ScalarType, N * N > matrix_;
+  mutable internal::DenseBuffer< ScalarType, N > rhs_;
+}; // class ReducedDense
+
+
+} // namespace StationaryDiscretization
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_DISCRETIZATIONS_REDUCED_HH
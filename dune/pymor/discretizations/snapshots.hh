@@ -0,0 +1,277 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_DISCRETIZATIONS_SNAPSHOTS_HH
+#define DUNE_PYMOR_DISCRETIZATIONS_SNAPSHOTS_HH
+
+#include <limits>
+#include <vector>
+#include <chrono>
+#include <exception>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#if HAVE_MPI
+# include <mpi.h>
+# include <dune/common/parallel/mpitraits.hh>
+#endif
+
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/base.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief The snapshots of a training set, distributed among the ranks of a communicator.
+ *
+ *        Each rank holds the snapshots it computed, local_indices()[ii] is the index within the training set of
+ *        local_vectors()[ii]. gather() collects all snapshots in the order of the training set on one rank.
+ */
+template< class VectorImp >
+class DistributedSnapshots
+{
+public:
+  typedef VectorImp                      VectorType;
+  typedef typename VectorType::ScalarType ScalarType;
+  typedef typename MPIHelper::MPICommunicator CommunicatorType;
+
+  DistributedSnapshots(const size_t global_size, CommunicatorType communicator)
+    : global_size_(global_size)
+    , communicator_(communicator)
+  {}
+
+  size_t size() const
+  {
+    return global_size_;
+  }
+
+  const std::vector< size_t >& local_indices() const
+  {
+    return local_indices_;
+  }
+
+  const std::vector< VectorType >& local_vectors() const
+  {
+    return local_vectors_;
+  }
+
+  //! wall time (in seconds) of the computation of each local snapshot
+  const std::vector< double >& local_timings() const
+  {
+    return local_timings_;
+  }
+
+  void push_back(const size_t index, VectorType&& vector, const double timing)
+  {
+    local_indices_.push_back(index);
+    local_vectors_.emplace_back(std::move(vector));
+    local_timings_.push_back(timing);
+  }
+
+  /**
+   * \brief Returns all snapshots in the order of the training set on rank root, an empty vector on all other ranks.
+   *
+   *        Collective, has to be called on all ranks.
+   */
+  std::vector< VectorType > gather(const int root = 0) const
+  {
+#if HAVE_MPI
+    int rank, num_ranks;
+    MPI_Comm_rank(communicator_, &rank);
+    MPI_Comm_size(communicator_, &num_ranks);
+    // the dispatching rank may not hold any vector, so agree on the dimension first
+    unsigned long long local_dim = local_vectors_.empty() ? 0 : local_vectors_[0].size();
+    unsigned long long dim = 0;
+    MPI_Allreduce(&local_dim, &dim, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, communicator_);
+    // agree on all errors before the gathers, such that all ranks throw instead of some waiting for the others
+    unsigned long long local_state[2] = {0, local_vectors_.size()};
+    for (const auto& vector : local_vectors_)
+      if (vector.size() != dim)
+        local_state[0] = 1;
+    unsigned long long state[2] = {0, 0};
+    MPI_Allreduce(local_state, state, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator_);
+    if (state[0] > 0)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "all snapshots have to be of the same size (" << dim << ")!");
+    if (state[1] != global_size_)
+      DUNE_THROW(Stuff::Exceptions::internal_error,
+                 "found " << state[1] << " snapshots, expected " << global_size_ << "!");
+    // the counts are given in vectors (and thus only have to fit into an int), each is sent as one contiguous type
+    const unsigned long long max_count = std::numeric_limits< int >::max();
+    if (dim > max_count || global_size_ > max_count)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "too many snapshots (" << global_size_ << ") or too large snapshots (" << dim << ") for MPI!");
+    std::vector< unsigned long long > indices(local_indices_.begin(), local_indices_.end());
+    std::vector< ScalarType > values(local_vectors_.size() * dim);
+    for (size_t ii = 0; ii < local_vectors_.size(); ++ii)
+      for (size_t jj = 0; jj < dim; ++jj)
+        values[ii * dim + jj] = local_vectors_[ii].get_entry(jj);
+    int local_count = int(indices.size());
+    std::vector< int > counts(num_ranks, 0);
+    MPI_Gather(&local_count, 1, MPI_INT, counts.data(), 1, MPI_INT, root, communicator_);
+    std::vector< int > displacements(num_ranks, 0);
+    for (int rr = 1; rr < num_ranks; ++rr)
+      displacements[rr] = displacements[rr - 1] + counts[rr - 1];
+    const size_t total = (rank == root) ? global_size_ : 0;
+    std::vector< unsigned long long > all_indices(total);
+    std::vector< ScalarType > all_values(total * dim);
+    MPI_Gatherv(indices.data(), local_count, MPI_UNSIGNED_LONG_LONG,
+                all_indices.data(), counts.data(), displacements.data(), MPI_UNSIGNED_LONG_LONG,
+                root, communicator_);
+    MPI_Datatype vector_type;
+    MPI_Type_contiguous(int(dim), MPITraits< ScalarType >::getType(), &vector_type);
+    MPI_Type_commit(&vector_type);
+    MPI_Gatherv(values.data(), local_count, vector_type,
+                all_values.data(), counts.data(), displacements.data(), vector_type,
+                root, communicator_);
+    MPI_Type_free(&vector_type);
+    std::vector< VectorType > ret;
+    if (rank != root)
+      return ret;
+    ret.resize(global_size_);
+    for (size_t ii = 0; ii < total; ++ii) {
+      VectorType vector(dim);
+      for (size_t jj = 0; jj < dim; ++jj)
+        vector.set_entry(jj, all_values[ii * dim + jj]);
+      ret[all_indices[ii]] = vector;
+    }
+    return ret;
+#else // HAVE_MPI
+    if (root != 0)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range, "root has to be 0 without MPI (is " << root << ")!");
+    std::vector< VectorType > ret(global_size_);
+    for (size_t ii = 0; ii < local_indices_.size(); ++ii)
+      ret[local_indices_[ii]] = local_vectors_[ii];
+    return ret;
+#endif // HAVE_MPI
+  } // ... gather(...)
+
+private:
+  size_t global_size_;
+  CommunicatorType communicator_;
+  std::vector< size_t > local_indices_;
+  std::vector< VectorType > local_vectors_;
+  std::vector< double > local_timings_;
+}; // class DistributedSnapshots
+
+
+/**
+ * \brief Computes num snapshots, solver(ii) has to return the snapshot ii, distributed among all ranks of communicator.
+ *
+ *        With dynamic load balancing (the default), rank 0 only hands out the indices one at a time to the other ranks
+ *        as soon as they are done with their previous one, such that ranks with long running solves do not hold back
+ *        the others. Otherwise the indices are distributed cyclically in advance and all ranks compute. Collective, has
+ *        to be called on all ranks. If solver throws on any rank, no further snapshots are handed out and all ranks
+ *        throw: the failing ranks rethrow their exception, all other ranks throw a ParallelError.
+ */
+template< class VectorType, class SolverType >
+DistributedSnapshots< VectorType > compute_snapshots(const size_t num,
+                                                     const SolverType& solver,
+                                                     typename MPIHelper::MPICommunicator communicator
+                                                        = MPIHelper::getCommunicator(),
+                                                     const bool dynamic = true)
+{
+  DistributedSnapshots< VectorType > ret(num, communicator);
+  std::exception_ptr error;
+  const auto compute = [&](const size_t ii) {
+    try {
+      const auto start = std::chrono::steady_clock::now();
+      VectorType vector = solver(ii);
+      ret.push_back(ii, std::move(vector),
+                    std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count());
+    } catch (...) {
+      error = std::current_exception();
+    }
+  };
+  int rank = 0;
+  int num_ranks = 1;
+#if HAVE_MPI
+  MPI_Comm_rank(communicator, &rank);
+  MPI_Comm_size(communicator, &num_ranks);
+#endif
+  if (num_ranks == 1) {
+    for (size_t ii = 0; ii < num && !error; ++ii)
+      compute(ii);
+  } else if (!dynamic) {
+    for (size_t ii = rank; ii < num && !error; ii += num_ranks)
+      compute(ii);
+  } else {
+#if HAVE_MPI
+    static const int request_tag = 4711;
+    static const int index_tag = 4712;
+    static const long long done = -1;
+    if (rank == 0) {
+      size_t next = 0;
+      bool failed = false;
+      int active = num_ranks - 1;
+      while (active > 0) {
+        // each request carries whether the previous snapshot of the requesting rank failed
+        int previous_failed;
+        MPI_Status status;
+        MPI_Recv(&previous_failed, 1, MPI_INT, MPI_ANY_SOURCE, request_tag, communicator, &status);
+        failed = failed || previous_failed;
+        const long long index = (next < num && !failed) ? (long long)(next++) : done;
+        if (index == done)
+          --active;
+        MPI_Send(&index, 1, MPI_LONG_LONG, status.MPI_SOURCE, index_tag, communicator);
+      }
+    } else {
+      while (true) {
+        int previous_failed = bool(error);
+        long long index;
+        MPI_Send(&previous_failed, 1, MPI_INT, 0, request_tag, communicator);
+        MPI_Recv(&index, 1, MPI_LONG_LONG, 0, index_tag, communicator, MPI_STATUS_IGNORE);
+        if (index == done)
+          break;
+        compute(size_t(index));
+      }
+    }
+#endif // HAVE_MPI
+  }
+  int local_failed = bool(error);
+  int failed = local_failed;
+#if HAVE_MPI
+  if (num_ranks > 1)
+    MPI_Allreduce(&local_failed, &failed, 1, MPI_INT, MPI_MAX, communicator);
+#endif
+  if (error)
+    std::rethrow_exception(error);
+  if (failed)
+    DUNE_THROW(ParallelError, "computing a snapshot failed on another rank!");
+  return ret;
+} // ... compute_snapshots(...)
+
+
+/**
+ * \brief Solves discretization for each of mus, distributed among all ranks of communicator (see above).
+ */
+template< class DiscretizationType >
+DistributedSnapshots< typename DiscretizationType::VectorType >
+compute_snapshots(const DiscretizationType& discretization,
+                  const Stuff::Common::Configuration& options,
+                  const std::vector< Parameter >& mus,
+                  typename MPIHelper::MPICommunicator communicator = MPIHelper::getCommunicator(),
+                  const bool dynamic = true)
+{
+  typedef typename DiscretizationType::VectorType VectorType;
+  return compute_snapshots< VectorType >(mus.size(),
+                                         [&](const size_t ii) {
+                                           VectorType vector = discretization.create_vector();
+                                           discretization.solve(options, vector, mus[ii]);
+                                           return vector;
+                                         },
+                                         communicator,
+                                         dynamic);
+} // ... compute_snapshots(...)
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_DISCRETIZATIONS_SNAPSHOTS_HH
@@ -11,10 +11,12 @@ import numpy as np
 
 from pymor.vectorarrays.numpy import NumpyVectorArray, NumpyVectorSpace
 from pymor.vectorarrays.interfaces import VectorSpace
-from pymor.vectorarrays.list import ListVectorArray
 from pymor.operators.basic import OperatorBase
 from pymor.operators.constructions import LincombOperator
 
+from dune.pymor.la.container import multi_vector_type
+
+
 def inject_VectorBasedImplementation(module, exceptions, interfaces, CONFIG_H, Traits, template_parameters=None):
     assert(isinstance(module, pybindgen.module.Module))
     assert(isinstance(exceptions, list))
@@ -56,18 +58,36 @@ def inject_VectorBasedImplementation(module, exceptions, interfaces, CONFIG_H, T
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions,
+                     unblock_threads=True)
     Class.add_method('apply',
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions,
+                     unblock_threads=True)
+    Class.add_method('apply',
+                     retval('std::vector< ' + ScalarType + ' >'),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources')],
+                     is_const=True,
+                     throw=exceptions,
+                     unblock_threads=True,
+                     custom_name='apply_multi')
+    Class.add_method('apply',
+                     retval('std::vector< ' + ScalarType + ' >'),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources'),
+                      param('const Dune::Pymor::Parameter', 'mu')],
+                     is_const=True,
+                     throw=exceptions,
+                     unblock_threads=True,
+                     custom_name='apply_multi')
     Class.add_method('as_vector_and_return_ptr',
                      retval(ContainerType + ' *', caller_owns_return=True),
                      [],
                      is_const=True,
                      throw=exceptions,
+                     unblock_threads=True,
                      custom_name='as_vector')
     return Class
 
@@ -77,6 +97,7 @@ class WrappedFunctionalBase(OperatorBase):
     wrapped_type = None
 
     vec_type_source = None
+    array_type = None
 
     range = NumpyVectorSpace(1)
 
@@ -85,7 +106,7 @@ class WrappedFunctionalBase(OperatorBase):
     def __init__(self, op):
         assert isinstance(op, self.wrapped_type)
         self._impl = op
-        self.source = VectorSpace(ListVectorArray, (self.vec_type_source, op.dim_source()))
+        self.source = VectorSpace(self.array_type, (self.vec_type_source, int(op.dim_source())))
         self.linear = op.linear()
         if hasattr(op, 'parametric') and op.parametric():
             pt = self._wrapper[op.parameter_type()]
@@ -93,27 +114,27 @@ class WrappedFunctionalBase(OperatorBase):
 
     def apply(self, U, ind=None, mu=None):
         assert U in self.source
-        vectors = U._list if ind is None else [U._list[i] for i in ind]
+        sources = U._selection(ind)
         if self.parametric:
             mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
-            R = np.array([self._impl.apply(v._impl, mu) for v in vectors])[..., np.newaxis]
-            return NumpyVectorArray(R, copy=False)
+            R = np.array(list(self._impl.apply_multi(sources, mu)))[..., np.newaxis]
         else:
-            R = np.array([self._impl.apply(v._impl) for v in vectors])[..., np.newaxis]
-            return NumpyVectorArray(R, copy=False)
+            R = np.array(list(self._impl.apply_multi(sources)))[..., np.newaxis]
+        return NumpyVectorArray(R, copy=False)
 
     def as_vector(self, mu=None):
         if self.parametric:
             mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
             if hasattr(self._impl, 'as_vector'):
-                return ListVectorArray([self.vec_type_source(self._impl.as_vector(mu))])
+                return self.array_type.from_vectors([self.vec_type_source(self._impl.as_vector(mu))])
             elif hasattr(self._impl, 'freeze_parameter'):
-                return ListVectorArray([self.vec_type_source(self._impl.freeze_parameter(mu).as_vector())])
+                vector = self._impl.freeze_parameter(mu).as_vector()
+                return self.array_type.from_vectors([self.vec_type_source(vector)])
             else:
                 raise NotImplementedError
         else:
             if hasattr(self._impl, 'as_vector'):
-                return ListVectorArray([self.vec_type_source(self._impl.as_vector())])
+                return self.array_type.from_vectors([self.vec_type_source(self._impl.as_vector())])
             else:
                 raise NotImplementedError
 
@@ -123,6 +144,7 @@ def wrap_functional(cls, wrapper):
     class WrappedFunctional(WrappedFunctionalBase):
         wrapped_type = cls
         vec_type_source = wrapper[cls.type_source()]
+        array_type = wrapper.multi_vector_class
         _wrapper = wrapper
 
         def __init__(self, op):
@@ -200,18 +222,36 @@ def inject_LinearAffinelyDecomposedVectorBasedImplementation(module,
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions,
+                     unblock_threads=True)
     Class.add_method('apply',
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions,
+                     unblock_threads=True)
+    Class.add_method('apply',
+                     retval('std::vector< ' + ScalarType + ' >'),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources')],
+                     is_const=True,
+                     throw=exceptions,
+                     unblock_threads=True,
+                     custom_name='apply_multi')
+    Class.add_method('apply',
+                     retval('std::vector< ' + ScalarType + ' >'),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources'),
+                      param('const Dune::Pymor::Parameter', 'mu')],
+                     is_const=True,
+                     throw=exceptions,
+                     unblock_threads=True,
+                     custom_name='apply_multi')
     Class.add_method('freeze_parameter_and_return_ptr',
                      retval(FrozenType + ' *', caller_owns_return=True),
                      [param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
                      throw=exceptions,
+                     unblock_threads=True,
                      custom_name='freeze_parameter')
     return Class
 
@@ -141,6 +141,8 @@ public:
       return freeze_parameter(mu).apply(source);
   }
 
+  using BaseType::apply;
+
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
   {
     if (!Parametric::parametric())
@@ -153,6 +155,21 @@ public:
     return FrozenType(new VectorType(affinelyDecomposedVector_.freeze_parameter(mu)));
   }
 
+  /**
+   * \brief Assembles the vector for mu into target, which is reused for all parameters.
+   */
+  void freeze_parameter_into(const Parameter mu, VectorType& target) const
+  {
+    if (!Parametric::parametric())
+      DUNE_THROW(Exceptions::this_is_not_parametric, "do not call freeze_parameter_into(" << mu << ")"
+                 << "if parametric() == false!");
+    if (mu.type() != Parametric::parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                 << Parametric::parameter_type() << ")!");
+    affinelyDecomposedVector_.freeze_parameter_into(mu, target);
+  }
+
   FrozenType* freeze_parameter_and_return_ptr(const Parameter mu = Parameter()) const
   {
     return new FrozenType(freeze_parameter(mu));
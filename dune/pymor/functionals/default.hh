@@ -83,6 +83,8 @@ public:
     return vector_->dot(source);
   }
 
+  using FunctionalInterface< Traits >::apply;
+
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
   {
     DUNE_THROW(Exceptions::this_is_not_parametric,
@@ -11,6 +11,7 @@
 
 #include <dune/pymor/common/exceptions.hh>
 #include <dune/pymor/common/crtp.hh>
+#include <dune/pymor/la/container/multivector.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
 
@@ -40,6 +41,7 @@ public:
   typedef typename Traits::SourceType   SourceType;
   typedef typename Traits::ScalarType   ScalarType;
   typedef typename Traits::FrozenType   FrozenType;
+  typedef LA::MultiVector< typename SourceType::ScalarType > MultiVectorType;
 
   static_assert(std::is_base_of< Stuff::LA::VectorInterface< typename SourceType::Traits >, SourceType >::value,
                 "SourceType has to be derived from Stuff::LA::VectorInterface!");
@@ -75,6 +77,33 @@ public:
     return CRTP::as_imp(*this).apply(source, mu);
   }
 
+  /**
+   * \brief Applies the functional to each vector of sources, a parametric functional is frozen only once.
+   */
+  std::vector< ScalarType > apply(const MultiVectorType& sources, const Parameter mu = Parameter()) const
+  {
+    if (static_cast< DUNE_STUFF_SSIZE_T >(sources.dim()) != dim_source())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of sources (" << sources.dim() << ") does not match the dim_source of this ("
+                 << dim_source() << ")!");
+    std::vector< ScalarType > ret(sources.len());
+    if (sources.len() == 0)
+      return ret;
+    SourceType source(dim_source());
+    if (this->parametric()) {
+      const auto frozen = freeze_parameter(mu);
+      for (size_t ii = 0; ii < sources.len(); ++ii) {
+        sources.get(ii, source);
+        ret[ii] = frozen.apply(source);
+      }
+    } else
+      for (size_t ii = 0; ii < sources.len(); ++ii) {
+        sources.get(ii, source);
+        ret[ii] = apply(source, mu);
+      }
+    return ret;
+  } // ... apply(...)
+
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
   {
     CHECK_INTERFACE_IMPLEMENTATION(CRTP::as_imp(*this).freeze_parameter(mu));
@@ -10,9 +10,14 @@ import numpy as np
 
 from pymor.core.defaults import defaults
 from pymor.core.interfaces import UberMeta
+from pymor.vectorarrays.interfaces import VectorArrayInterface
 from pymor.vectorarrays.list import VectorInterface, ListVectorArray
 
 
+def multi_vector_type(ScalarType):
+    return 'Dune::Pymor::LA::MultiVector< ' + ScalarType + ' >'
+
+
 def make_listvectorarray(vec, count=1):
     if isinstance(vec, (list, tuple)):
         lva = ListVectorArray.make_array(subtype=(type(vec[0]), vec[0].dim), count=len(vec))
@@ -23,24 +28,42 @@ def make_listvectorarray(vec, count=1):
     return lva
 
 
-# ReturnValue for converting a raw C pointer to a PyBuffer object
-# from pybindgen/examples/buffer/modulegen.py
-class BufferReturn(pybindgen.ReturnValue):
-    CTYPES = []
-
-    def __init__(self, ctype, length_expression):
-        super(BufferReturn, self).__init__(ctype, is_const=False)
-        self.length_expression = length_expression
-
-    def convert_c_to_python(self, wrapper):
-        pybuf = wrapper.after_call.declare_variable("PyObject*", "pybuf")
-        wrapper.after_call.write_code("%s = PyBuffer_FromReadWriteMemory(retval, %s);"
-                                      % (pybuf, self.length_expression))
-        wrapper.build_params.add_parameter("N", [pybuf], prepend=True)
+def create_instance(cpp_class, code_block, lvalue, parameters, construct_type_name):
+    """Creates the instances of classes which export or map buffers, see Dune::Pymor::Bindings::create."""
+    code_block.write_code('%s = Dune::Pymor::Bindings::create< %s >(%s);' % (lvalue, construct_type_name, parameters))
+
+
+def inject_buffer(Class, ThisType):
+    """Adds buffer(), which returns a writable memoryview (PEP 3118) of the entries without copying them.
+
+    The memoryview keeps the vector alive, copies of the vector are deep while a memoryview exists, see
+    Dune::Pymor::Bindings::buffer. num_exports() returns the number of live memoryviews.
+    """
+    Class.set_instance_creation_function(create_instance)
+    wrapper_name = '_wrap_' + Class.pystruct + '_buffer'
+    Class.add_custom_method_wrapper(
+        'buffer',
+        wrapper_name,
+        ('PyObject* ' + wrapper_name + '(' + Class.pystruct + ' *self, PyObject *PYBINDGEN_UNUSED(args),\n'
+         '    PyObject *PYBINDGEN_UNUSED(kwargs), PyObject **PYBINDGEN_UNUSED(return_exception))\n'
+         '{\n'
+         '  return Dune::Pymor::Bindings::buffer< ' + ThisType + ' >(*self->obj, (PyObject*)self);\n'
+         '}'),
+        flags=['METH_VARARGS', 'METH_KEYWORDS'])
+    wrapper_name = '_wrap_' + Class.pystruct + '_num_exports'
+    Class.add_custom_method_wrapper(
+        'num_exports',
+        wrapper_name,
+        ('PyObject* ' + wrapper_name + '(' + Class.pystruct + ' *self, PyObject *PYBINDGEN_UNUSED(args),\n'
+         '    PyObject *PYBINDGEN_UNUSED(kwargs), PyObject **PYBINDGEN_UNUSED(return_exception))\n'
+         '{\n'
+         '  return PyLong_FromSize_t(Dune::Pymor::Bindings::num_exports< ' + ThisType + ' >(*self->obj));\n'
+         '}'),
+        flags=['METH_VARARGS', 'METH_KEYWORDS'])
 
 
 def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name, Traits, template_parameters=None,
-                                provides_data=False):
+                                provides_data=False, maps_buffer=False):
     assert(isinstance(module, pybindgen.module.Module))
     assert(isinstance(exceptions, list))
     assert(isinstance(interfaces, dict))
@@ -71,9 +94,15 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
     if len(namespaces) > 0:
         for nspace in namespaces:
             namespace = namespace.add_cpp_namespace(nspace)
+    # the mapped python buffer is released on deletion, see Dune::Pymor::Bindings::map_buffer
+    memory_policy = (pybindgen.cppclass.FreeFunctionPolicy('Dune::Pymor::Bindings::release< ' + ThisType + ' >')
+                     if maps_buffer else None)
     Class = namespace.add_class(name,
                                 parent=interfaces['Dune::Stuff::LA::Tags::VectorInterface'],
-                                template_parameters=template_parameters)
+                                template_parameters=template_parameters,
+                                memory_policy=memory_policy)
+    if maps_buffer:
+        Class.set_instance_creation_function(create_instance)
     Class.add_constructor([])
     Class.add_constructor([param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'size')])
     Class.add_constructor([param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'size'), param(ScalarType, 'value')])
@@ -101,7 +130,7 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
                      [], is_const=True, throw=exceptions)
     # what we want from ProvidesData interface
     if provides_data:
-        Class.add_method('data', BufferReturn(ScalarType + ' *', 'self->obj->size()  * sizeof(' + ScalarType + ')'), [])
+        inject_buffer(Class, ThisType)
     # what we want from VectorInterface
     Class.add_method('almost_equal',
                      retval('bool'),
@@ -185,7 +214,12 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
                      [param('const std::vector< ' + CONFIG_H['DUNE_STUFF_SSIZE_T'] + '> &', 'component_indices')],
                      is_const=True,
                      throw=exceptions)
-
+    # has to come last, since PyObject* matches the arguments of all other constructors
+    if maps_buffer:
+        Class.add_function_as_constructor('Dune::Pymor::Bindings::map_buffer< ' + ScalarType + ' >',
+                                          retval(ThisType + ' *', caller_owns_return=True),
+                                          [param('PyObject*', 'buffer', transfer_ownership=False)],
+                                          throw=exceptions)
 
     return module, Class
 
@@ -310,6 +344,97 @@ def inject_MatrixImplementation(module, exceptions, interfaces, CONFIG_H, name,
     return module, Class
 
 
+def inject_MultiVector(module, exceptions, interfaces, CONFIG_H, VectorTypes, ScalarType='double'):
+    """Adds Dune::Pymor::LA::MultiVector< ScalarType >, which can be filled from and copied to each of VectorTypes."""
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(interfaces, dict))
+    assert(isinstance(CONFIG_H, dict))
+    assert(isinstance(VectorTypes, list))
+    for element in VectorTypes:
+        assert(isinstance(element, str))
+        assert(len(element.strip()) > 0)
+    assert('Dune::Pymor::Tags::MultiVectorInterface' in interfaces)
+    ThisType = multi_vector_type(ScalarType)
+    ssize_t = CONFIG_H['DUNE_STUFF_SSIZE_T']
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor').add_cpp_namespace('LA')
+    Class = namespace.add_class('MultiVector',
+                                parent=interfaces['Dune::Pymor::Tags::MultiVectorInterface'],
+                                template_parameters=[ScalarType])
+    Class.add_constructor([param('const size_t', 'dd')])
+    Class.add_constructor([param('const size_t', 'dd'), param('const size_t', 'll')])
+    Class.add_copy_constructor()
+    Class.add_method('type_this', retval('std::string'), [], is_const=True, is_static=True, throw=exceptions)
+    Class.add_method('pb_dim', retval(ssize_t), [], is_const=True, throw=exceptions, custom_name='dim')
+    Class.add_method('pb_len', retval(ssize_t), [], is_const=True, throw=exceptions, custom_name='len')
+    Class.add_method('reserve', None, [param('const size_t', 'll')], throw=exceptions)
+    Class.add_method('copy', retval(ThisType), [], is_const=True, throw=exceptions)
+    Class.add_method('pb_copy',
+                     retval(ThisType),
+                     [param('const std::vector< ' + ssize_t + ' > &', 'indices')],
+                     is_const=True, throw=exceptions,
+                     custom_name='copy')
+    Class.add_method('append', None, [param('const ' + ThisType + ' &', 'other')], throw=exceptions)
+    Class.add_method('pb_append',
+                     None,
+                     [param('const ' + ThisType + ' &', 'other'),
+                      param('const std::vector< ' + ssize_t + ' > &', 'indices')],
+                     throw=exceptions,
+                     custom_name='append')
+    Class.add_method('pb_remove',
+                     None,
+                     [param('const std::vector< ' + ssize_t + ' > &', 'indices')],
+                     throw=exceptions,
+                     custom_name='remove')
+    for VectorType in VectorTypes:
+        Class.add_method('append', None, [param('const ' + VectorType + ' &', 'vector')],
+                         template_parameters=[VectorType], throw=exceptions)
+        Class.add_method('get',
+                         None,
+                         [param('const size_t', 'ii'), param(VectorType + ' &', 'vector')],
+                         template_parameters=[VectorType], is_const=True, throw=exceptions)
+        Class.add_method('set',
+                         None,
+                         [param('const size_t', 'ii'), param('const ' + VectorType + ' &', 'vector')],
+                         template_parameters=[VectorType], throw=exceptions)
+    Class.add_method('scal', None, [param('const ' + ScalarType + ' &', 'alpha')], throw=exceptions)
+    Class.add_method('scal',
+                     None,
+                     [param('const std::vector< ' + ScalarType + ' > &', 'alphas')],
+                     throw=exceptions)
+    Class.add_method('axpy',
+                     None,
+                     [param('const ' + ScalarType + ' &', 'alpha'),
+                      param('const ' + ThisType + ' &', 'xx')],
+                     throw=exceptions)
+    Class.add_method('axpy',
+                     None,
+                     [param('const std::vector< ' + ScalarType + ' > &', 'alphas'),
+                      param('const ' + ThisType + ' &', 'xx')],
+                     throw=exceptions)
+    Class.add_method('pb_dot',
+                     retval(ThisType),
+                     [param('const ' + ThisType + ' &', 'other')],
+                     is_const=True, throw=exceptions,
+                     custom_name='dot')
+    Class.add_method('pairwise_dot',
+                     retval('std::vector< ' + ScalarType + ' >'),
+                     [param('const ' + ThisType + ' &', 'other')],
+                     is_const=True, throw=exceptions)
+    Class.add_method('pb_gramian', retval(ThisType), [], is_const=True, throw=exceptions, custom_name='gramian')
+    Class.add_method('pb_lincomb',
+                     retval(ThisType),
+                     [param('const std::vector< ' + ScalarType + ' > &', 'coefficients'),
+                      param('const ' + ssize_t, 'num')],
+                     is_const=True, throw=exceptions,
+                     custom_name='lincomb')
+    Class.add_method('l1_norm', retval('std::vector< ' + ScalarType + ' >'), [], is_const=True, throw=exceptions)
+    Class.add_method('l2_norm', retval('std::vector< ' + ScalarType + ' >'), [], is_const=True, throw=exceptions)
+    Class.add_method('sup_norm', retval('std::vector< ' + ScalarType + ' >'), [], is_const=True, throw=exceptions)
+    inject_buffer(Class, ThisType)
+    return module, Class
+
+
 class WrappedMeta(UberMeta):
     pass
 
@@ -324,11 +449,19 @@ def wrap_vector(cls):
 
         @property
         def data(self):
-            return np.frombuffer(self._impl.data(), dtype=np.float64)
+            return np.frombuffer(self._impl.buffer(), dtype=np.float64)
 
         def __init__(self, v):
             self._impl = v
 
+        @classmethod
+        def from_array(cls, array):
+            """Wraps the memory of a contiguous one dimensional float64 array without copying it.
+
+            Only supported by mapped vector types, the wrapped vector keeps the array alive.
+            """
+            return cls(cls.wrapped_type(array))
+
         @classmethod
         def make_array(cls, subtype=None, count=0, reserve=0):
             assert count > 0
@@ -431,6 +564,212 @@ def wrap_vector(cls):
     return WrappedVector
 
 
+def wrap_multi_vector(cls):
+
+    class MultiVectorArray(VectorArrayInterface):
+        """VectorArray of the vectors of a wrapped Dune::Pymor::LA::MultiVector, stored in one contiguous block.
+
+        The subtype is (vec_type, dim), where vec_type is the wrapped vector type the vectors are converted to and
+        from (see vector() and from_vectors()), such that arrays belonging to different discretizations (with
+        different vector types) are not mixed.
+        """
+
+        __metaclass__ = WrappedMeta
+
+        wrapped_type = cls
+
+        def __init__(self, impl, vec_type):
+            assert isinstance(impl, self.wrapped_type)
+            self._impl = impl
+            self.vec_type = vec_type
+
+        @classmethod
+        def make_array(cls, subtype=None, count=0, reserve=0):
+            vec_type, dim = subtype
+            impl = cls.wrapped_type(dim, count)
+            if reserve > count:
+                impl.reserve(reserve)
+            return cls(impl, vec_type)
+
+        @classmethod
+        def from_vectors(cls, vectors):
+            """Copies the given wrapped vectors (all of the same type and dim) into a new array."""
+            assert len(vectors) > 0
+            vec_type, dim = type(vectors[0]), vectors[0].dim
+            impl = cls.wrapped_type(dim)
+            impl.reserve(len(vectors))
+            for v in vectors:
+                assert type(v) == vec_type
+                impl.append(v._impl)
+            return cls(impl, vec_type)
+
+        def vector(self, ii):
+            """Returns a copy of the vector ii as a wrapped vector of type vec_type."""
+            v = self.vec_type.make_zeros(self.dim)
+            self._impl.get(int(ii), v._impl)
+            return v
+
+        @property
+        def data(self):
+            """A (len(self), dim) view of the storage, append() raises a BufferError as long as a view exists."""
+            if len(self) == 0 or self.dim == 0:
+                return np.zeros((len(self), self.dim))
+            return np.frombuffer(self._impl.buffer(), dtype=np.float64).reshape((len(self), self.dim))
+
+        @property
+        def subtype(self):
+            return (self.vec_type, self.dim)
+
+        @property
+        def dim(self):
+            return int(self._impl.dim())
+
+        def __len__(self):
+            return int(self._impl.len())
+
+        def __getstate__(self):
+            return (self.vec_type, self.dim, self.data.copy())
+
+        def __setstate__(self, state):
+            self.vec_type, dim, data = state
+            self._impl = self.wrapped_type(dim, len(data))
+            self.data[:] = data
+
+        def _indices(self, ind):
+            if ind is None:
+                return None
+            if not hasattr(ind, '__len__'):
+                ind = [ind]
+            assert all(0 <= i < len(self) for i in ind)
+            return [int(i) for i in ind]
+
+        def _selection(self, ind):
+            ind = self._indices(ind)
+            return self._impl if ind is None else self._impl.copy(ind)
+
+        def _compatible(self, other):
+            return type(other) == type(self) and other.subtype == self.subtype
+
+        def copy(self, ind=None):
+            ind = self._indices(ind)
+            return type(self)(self._impl.copy() if ind is None else self._impl.copy(ind), self.vec_type)
+
+        def _check_not_exported(self):
+            # append() and reserve() may move the storage, which would leave the views of data dangling
+            if self._impl.num_exports() > 0:
+                raise BufferError('cannot grow an array while views of its data exist')
+
+        def append(self, other, o_ind=None, remove_from_other=False):
+            assert self._compatible(other)
+            assert not remove_from_other or other is not self
+            self._check_not_exported()
+            o_ind = other._indices(o_ind)
+            if o_ind is None:
+                self._impl.append(other._impl)
+            else:
+                self._impl.append(other._impl, o_ind)
+            if remove_from_other:
+                other.remove(o_ind)
+
+        def remove(self, ind=None):
+            ind = self._indices(ind)
+            if ind is None:
+                self._impl = self.wrapped_type(self.dim)
+            else:
+                self._impl.remove(ind)
+
+        def replace(self, other, ind=None, o_ind=None, remove_from_other=False):
+            assert self._compatible(other)
+            assert not remove_from_other or other is not self
+            ind, o_ind = self._indices(ind), other._indices(o_ind)
+            values = other.data if o_ind is None else other.data[o_ind]
+            if ind is None:
+                assert len(values) == len(self)
+                self.data[:] = values
+            else:
+                assert len(values) == len(ind)
+                self.data[ind] = values
+            if remove_from_other:
+                other.remove(o_ind)
+
+        def almost_equal(self, other, ind=None, o_ind=None, rtol=None, atol=None):
+            assert self._compatible(other)
+            rtol = rtol if rtol is not None else 2**4 * np.finfo(np.zeros(1.).dtype).eps
+            atol = atol if atol is not None else 0.
+            ind, o_ind = self._indices(ind), other._indices(o_ind)
+            X = self.data if ind is None else self.data[ind]
+            Y = other.data if o_ind is None else other.data[o_ind]
+            return np.all(np.abs(X - Y) <= atol + rtol * np.abs(Y), axis=1)
+
+        def scal(self, alpha, ind=None):
+            ind = self._indices(ind)
+            if ind is None:
+                self._impl.scal(float(alpha) if np.ndim(alpha) == 0 else [float(a) for a in alpha])
+            else:
+                data = self.data
+                data[ind] *= alpha if np.ndim(alpha) == 0 else np.asarray(alpha)[:, np.newaxis]
+
+        def axpy(self, alpha, x, ind=None, x_ind=None):
+            assert self._compatible(x)
+            ind, x_ind = self._indices(ind), x._indices(x_ind)
+            if ind is None and x_ind is None:
+                self._impl.axpy(float(alpha) if np.ndim(alpha) == 0 else [float(a) for a in alpha], x._impl)
+            else:
+                X = x.data if x_ind is None else x.data[x_ind]
+                data = self.data
+                if ind is None:
+                    ind = range(len(self))
+                data[ind] += X * (alpha if np.ndim(alpha) == 0 else np.asarray(alpha)[:, np.newaxis])
+
+        def dot(self, other, pairwise, ind=None, o_ind=None):
+            assert self._compatible(other)
+            A, B = self._selection(ind), other._selection(o_ind)
+            if pairwise:
+                return np.array(list(A.pairwise_dot(B)))
+            products = type(self)(A.dot(B), self.vec_type)
+            return products.data.reshape((int(A.len()), int(B.len())))
+
+        def gramian(self, ind=None):
+            A = self._selection(ind)
+            products = type(self)(A.gramian(), self.vec_type)
+            return products.data.reshape((int(A.len()), int(A.len())))
+
+        def lincomb(self, coefficients, ind=None):
+            A = self._selection(ind)
+            coefficients = np.asarray(coefficients, dtype=np.float64)
+            if coefficients.ndim == 1:
+                coefficients = coefficients[np.newaxis, :]
+            assert coefficients.ndim == 2 and coefficients.shape[1] == A.len()
+            return type(self)(A.lincomb(list(coefficients.ravel()), len(coefficients)), self.vec_type)
+
+        def l1_norm(self, ind=None):
+            return np.array(list(self._selection(ind).l1_norm()))
+
+        def l2_norm(self, ind=None):
+            return np.array(list(self._selection(ind).l2_norm()))
+
+        def sup_norm(self, ind=None):
+            return np.array(list(self._selection(ind).sup_norm()))
+
+        def components(self, component_indices, ind=None):
+            ind = self._indices(ind)
+            data = self.data if ind is None else self.data[ind]
+            return data[:, component_indices]
+
+        def amax(self, ind=None):
+            ind = self._indices(ind)
+            A = np.abs(self.data if ind is None else self.data[ind])
+            max_ind = np.argmax(A, axis=1) if A.shape[1] > 0 else np.zeros(len(A), dtype=int)
+            max_val = A[np.arange(len(A)), max_ind] if A.shape[1] > 0 else np.zeros(len(A))
+            return max_ind, max_val
+
+    MultiVectorArray.__name__ = cls.__name__ + 'Array'
+
+    wrapped_vectors[cls] = MultiVectorArray
+
+    return MultiVectorArray
+
+
 # make vector types picklable
 
 import copy_reg
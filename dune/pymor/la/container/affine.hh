@@ -6,8 +6,12 @@
 #ifndef DUNE_PYMOR_LA_CONTAINER_AFFINE_HH
 #define DUNE_PYMOR_LA_CONTAINER_AFFINE_HH
 
+#include <atomic>
+#include <cassert>
 #include <memory>
+#include <mutex>
 #include <vector>
+#include <algorithm>
 #include <type_traits>
 
 #include <boost/numeric/conversion/cast.hpp>
@@ -23,6 +27,8 @@
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
 
+#include "lincomb.hh"
+
 namespace Dune {
 namespace Pymor {
 namespace LA {
@@ -66,12 +72,14 @@ public:
     : hasAffinePart_(true)
     , num_components_(0)
     , affinePart_(aff_ptr)
+    , containers_({affinePart_})
   {}
 
   AffinelyDecomposedConstContainer(const std::shared_ptr< const ContainerType > aff_ptr)
     : hasAffinePart_(true)
     , num_components_(0)
     , affinePart_(aff_ptr)
+    , containers_({affinePart_})
   {}
 
   /**
@@ -83,7 +91,8 @@ public:
   {
     components_.emplace_back(comp_ptr);
     coefficients_.emplace_back(coeff_ptr);
-    inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
+    containers_.push_back(components_[0]);
+    projections_.push_back(inherit_coefficient_type(*coeff_ptr, 0));
   }
 
   /**
@@ -96,7 +105,8 @@ public:
   {
     components_.push_back(comp_ptr);
     coefficients_.emplace_back(coeff_ptr);
-    inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
+    containers_.push_back(components_[0]);
+    projections_.push_back(inherit_coefficient_type(*coeff_ptr, 0));
   }
 
   /**
@@ -109,7 +119,8 @@ public:
   {
     components_.emplace_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
-    inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
+    containers_.push_back(components_[0]);
+    projections_.push_back(inherit_coefficient_type(*coeff_ptr, 0));
   }
 
   AffinelyDecomposedConstContainer(const std::shared_ptr< const ContainerType > comp_ptr,
@@ -119,7 +130,8 @@ public:
   {
     components_.push_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
-    inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
+    containers_.push_back(components_[0]);
+    projections_.push_back(inherit_coefficient_type(*coeff_ptr, 0));
   }
 
   bool has_affine_part() const
@@ -150,6 +162,8 @@ public:
                             "the shape of aff_ptr does not match the shape of the existing containers!");
     affinePart_ = aff_ptr;
     hasAffinePart_ = true;
+    containers_.insert(containers_.begin(), affinePart_);
+    assembler_ = std::make_shared< Assembler< ContainerType > >();
   }
 
   /**
@@ -193,7 +207,9 @@ public:
                    "the shape of aff_ptr does not match the shape of the existing components!");
     components_.push_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
-    inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_" + Dune::Stuff::Common::toString(num_components_));
+    containers_.push_back(comp_ptr);
+    projections_.push_back(inherit_coefficient_type(*coeff_ptr, num_components_));
+    assembler_ = std::make_shared< Assembler< ContainerType > >();
     ++num_components_;
     return num_components_ - 1;
   }
@@ -236,34 +252,92 @@ public:
       DUNE_THROW(Exceptions::wrong_parameter_type,
                  "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
                        << parameter_type() << ")!");
-    if (num_components_ == 0 && !hasAffinePart_)
-      DUNE_THROW(Stuff::Exceptions::requirements_not_met,
-                 "do not call freeze_parameter() if num_components() == 0 and has_affine_part() == false!");
-    if (components_.size() != boost::numeric_cast< size_t >(num_components_))
-     DUNE_THROW(Stuff::Exceptions::internal_error, "");
-    if (coefficients_.size() != boost::numeric_cast< size_t >(num_components_))
+    return freeze_parameter(FlatParameter(mu));
+  } // ... freeze_parameter(...)
+
+  /**
+   * \brief The number of entries of the scratch space required by evaluate_coefficients().
+   */
+  size_t scratch_size() const
+  {
+    return scratch_size_;
+  }
+
+  /**
+   * \brief Evaluates all coefficients for mu, thetas[qq] corresponds to coefficient(qq).
+   * \param thetas  has to provide num_components() entries
+   * \param scratch has to provide scratch_size() entries, used to map mu to the parameter of each coefficient
+   */
+  void evaluate_coefficients(const FlatParameter& mu, double* thetas, double* scratch) const
+  {
+    if (!mu.has_type(parameter_type()))
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.parameter().type() << ") does not match the parameter_type of this ("
+                       << parameter_type() << ")!");
+    if (coefficients_.size() != boost::numeric_cast< size_t >(num_components_)
+        || projections_.size() != coefficients_.size())
       DUNE_THROW(Stuff::Exceptions::internal_error, "");
-    if (hasAffinePart_ && (num_components_ == 0))
+    for (size_t qq = 0; qq < coefficients_.size(); ++qq) {
+      const auto& projection = parameter_projection(projections_[qq]);
+      thetas[qq] = coefficients_[qq]->evaluate(projection.map(mu.data(), scratch), projection.dim());
+    }
+  } // ... evaluate_coefficients(...)
+
+  /**
+   * \brief Evaluates all coefficients for mu into thetas, which is resized to num_components().
+   *
+   *        thetas is also used as scratch space, reusing it for several calls thus does not allocate.
+   */
+  void evaluate_coefficients(const FlatParameter& mu, std::vector< double >& thetas) const
+  {
+    const size_t num_thetas = coefficients_.size();
+    thetas.resize(num_thetas + scratch_size_);
+    evaluate_coefficients(mu, thetas.data(), thetas.data() + num_thetas);
+    thetas.resize(num_thetas);
+  } // ... evaluate_coefficients(...)
+
+  ContainerType freeze_parameter(const FlatParameter& mu) const
+  {
+    if (hasAffinePart_ && (num_components_ == 0)) {
+      check_freeze_parameter(mu);
       return *affinePart_;
-    else if (!hasAffinePart_ && num_components_ == 1) {
+    }
+    std::vector< double > evals;
+    collect(mu, evals);
+    if (!hasAffinePart_ && num_components_ == 1) {
       auto ret = components_[0]->copy();
-      ret.scal(coefficients_[0]->evaluate(map_parameter(mu, "coefficient_0")));
+      ret.scal(evals[0]);
       return ret;
-    } else {
-      std::vector< std::shared_ptr< const ContainerType > > containers;
-      std::vector< double > evals;
-      if (hasAffinePart_) {
-        containers.push_back(affinePart_);
-        evals.push_back(1.);
-      }
-      for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq) {
-        containers.push_back(components_[qq]);
-        evals.push_back(coefficients_[qq]->evaluate(map_parameter(mu, "coefficient_" + Dune::Stuff::Common::toString(qq))));
-      }
-      return Assemble< ContainerType >::lincomb(containers, evals);
-    }
+    } else
+      return assembler_->lincomb(containers_, evals);
   } // ... freeze_parameter(...)
 
+  /**
+   * \brief Assembles the container for mu into target, reusing its memory if possible.
+   *
+   *        If target has the shape (and, for sparse matrices, the pattern) of a previously frozen container, no memory
+   *        is allocated. Otherwise target is replaced once.
+   * \attention For sparse matrices, only the shape and the number of nonzeroes of target are compared (the full pattern
+   *            only if NDEBUG is not defined). A target with the number of nonzeroes of a frozen container thus has to
+   *            have its pattern as well, which is the case for any container previously frozen by this.
+   */
+  void freeze_parameter_into(const Parameter mu, ContainerType& target) const
+  {
+    if (mu.type() != parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                       << parameter_type() << ")!");
+    freeze_parameter_into(FlatParameter(mu), target);
+  } // ... freeze_parameter_into(...)
+
+  void freeze_parameter_into(const FlatParameter& mu, ContainerType& target) const
+  {
+    // reused by all calls on this thread, such that assembling into target does not allocate
+    static thread_local std::vector< double > evals;
+    collect(mu, evals);
+    assembler_->lincomb(containers_, evals, target);
+  } // ... freeze_parameter_into(...)
+
   ThisType copy()
   {
     ThisType ret;
@@ -286,62 +360,248 @@ public:
   } // ... pruned(...)
 
 protected:
+  void check_freeze_parameter(const FlatParameter& mu) const
+  {
+    if (!mu.has_type(parameter_type()))
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.parameter().type() << ") does not match the parameter_type of this ("
+                       << parameter_type() << ")!");
+    if (num_components_ == 0 && !hasAffinePart_)
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met,
+                 "do not call freeze_parameter() if num_components() == 0 and has_affine_part() == false!");
+    if (components_.size() != boost::numeric_cast< size_t >(num_components_))
+      DUNE_THROW(Stuff::Exceptions::internal_error, "");
+  } // ... check_freeze_parameter(...)
+
+  /**
+   * \brief Computes the coefficients of containers_ for mu, i.e., 1 for the affine part followed by the coefficients.
+   *
+   *        evals is also used as scratch space, reusing it for several calls thus does not allocate.
+   */
+  void collect(const FlatParameter& mu, std::vector< double >& evals) const
+  {
+    check_freeze_parameter(mu);
+    const size_t num_evals = containers_.size();
+    const size_t offset = hasAffinePart_ ? 1 : 0;
+    evals.resize(num_evals + scratch_size_);
+    if (hasAffinePart_)
+      evals[0] = 1.;
+    evaluate_coefficients(mu, evals.data() + offset, evals.data() + num_evals);
+    evals.resize(num_evals);
+  } // ... collect(...)
+
+  size_t inherit_coefficient_type(const ParameterFunctional& coefficient, const size_t qq)
+  {
+    scratch_size_ = std::max(scratch_size_, coefficient.parameter_type().layout()->dim());
+    return inherit_parameter_type(coefficient.parameter_type(), "coefficient_" + Dune::Stuff::Common::toString(qq));
+  }
+
   template< class CC, bool anything = true >
-  struct Assemble
+  class Assembler
   {
-    static CC lincomb(const std::vector< std::shared_ptr< const CC > >& containers,
-                      const std::vector< double >& evals)
+  public:
+    CC lincomb(const std::vector< std::shared_ptr< const CC > >& containers, const std::vector< double >& evals) const
     {
-      assert(containers.size() == evals.size());
-      assert(containers.size() > 0);
-      auto ret = containers[0]->copy();
-      ret.scal(evals[0]);
-      for (size_t qq = 1; qq < containers.size(); ++qq)
-        ret.axpy(evals[qq], *containers[qq]);
-      return ret;
+      return Pymor::LA::lincomb(containers, evals);
     }
-  }; // struct Assemble
+
+    void lincomb(const std::vector< std::shared_ptr< const CC > >& containers,
+                 const std::vector< double >& evals,
+                 CC& target) const
+    {
+      if (target.has_equal_shape(*containers[0]))
+        Pymor::LA::lincomb(containers, evals, target);
+      else
+        target = lincomb(containers, evals);
+    }
+
+    void invalidate() const {}
+  }; // class Assembler
 
 #if HAVE_DUNE_ISTL
 
+  /**
+   * \brief Assembles sparse matrices using a cached merged pattern.
+   *
+   *        The union of the patterns of all containers is computed on first use, together with the position of each
+   *        entry of each container in the corresponding row of the merged pattern. Any subsequent assembly copies the
+   *        (zero) template matrix and accumulates the values, without building, sorting or comparing any pattern.
+   *
+   *        The patterns of the containers are not compared on assembly (unless NDEBUG is undefined), the structure is
+   *        rather recomputed after each call to invalidate(). An AffinelyDecomposedContainer calls it whenever it
+   *        hands out a writable container.
+   */
   template< class SS, bool anything >
-  struct Assemble< Stuff::LA::IstlRowMajorSparseMatrix< SS >, anything >
+  class Assembler< Stuff::LA::IstlRowMajorSparseMatrix< SS >, anything >
   {
     typedef Stuff::LA::IstlRowMajorSparseMatrix< SS > CC;
 
-    static CC lincomb(const std::vector< std::shared_ptr< const CC > >& containers,
-                      const std::vector< double >& evals)
+    struct Structure
+    {
+      Structure(const std::vector< std::shared_ptr< const CC > >& containers, const size_t vv)
+        : pattern(containers[0]->rows())
+        , positions(containers.size())
+        , version(vv)
+      {
+        for (size_t qq = 0; qq < containers.size(); ++qq) {
+          const auto container_pattern = containers[qq]->pattern();
+          for (size_t ii = 0; ii < container_pattern.size(); ++ii)
+            for (const size_t& jj : container_pattern.inner(ii))
+              pattern.insert(ii, jj);
+        }
+        pattern.sort();
+        merged = std::make_shared< CC >(containers[0]->rows(), containers[0]->cols(), pattern);
+        for (size_t qq = 0; qq < containers.size(); ++qq) {
+          const auto& backend = containers[qq]->backend();
+          positions[qq].reserve(backend.nonzeroes());
+          for (size_t ii = 0; ii < backend.N(); ++ii) {
+            if (backend.getrowsize(ii) == 0)
+              continue;
+            const auto& merged_columns = pattern.inner(ii);
+            const auto row_end = backend[ii].end();
+            for (auto it = backend[ii].begin(); it != row_end; ++it)
+              positions[qq].push_back(std::lower_bound(merged_columns.begin(), merged_columns.end(), it.index())
+                                      - merged_columns.begin());
+          }
+        }
+      } // Structure(...)
+
+      bool has_pattern_of(const CC& target) const
+      {
+        const auto& backend = target.backend();
+        if (target.rows() != merged->rows() || target.cols() != merged->cols()
+            || backend.nonzeroes() != merged->backend().nonzeroes())
+          return false;
+        for (size_t ii = 0; ii < backend.N(); ++ii) {
+          const auto& merged_columns = pattern.inner(ii);
+          if (backend.getrowsize(ii) != merged_columns.size())
+            return false;
+          if (merged_columns.empty())
+            continue;
+          size_t kk = 0;
+          const auto row_end = backend[ii].end();
+          for (auto it = backend[ii].begin(); it != row_end; ++it, ++kk)
+            if (it.index() != merged_columns[kk])
+              return false;
+        }
+        return true;
+      } // ... has_pattern_of(...)
+
+      //! only for sanity checks, since it traverses the patterns of all containers
+      bool matches(const std::vector< std::shared_ptr< const CC > >& containers) const
+      {
+        if (containers.size() != positions.size())
+          return false;
+        for (size_t qq = 0; qq < containers.size(); ++qq) {
+          const auto& backend = containers[qq]->backend();
+          const auto& container_positions = positions[qq];
+          if (backend.N() != pattern.size() || backend.nonzeroes() != container_positions.size())
+            return false;
+          size_t cursor = 0;
+          for (size_t ii = 0; ii < backend.N(); ++ii) {
+            if (backend.getrowsize(ii) == 0)
+              continue;
+            const auto& merged_columns = pattern.inner(ii);
+            const auto row_end = backend[ii].end();
+            for (auto it = backend[ii].begin(); it != row_end; ++it, ++cursor)
+              if (container_positions[cursor] >= merged_columns.size()
+                  || merged_columns[container_positions[cursor]] != it.index())
+                return false;
+          }
+        }
+        return true;
+      } // ... matches(...)
+
+      Stuff::LA::SparsityPatternDefault pattern;
+      std::shared_ptr< const CC > merged;
+      std::vector< std::vector< size_t > > positions;
+      //! the value of Assembler::version_ this structure was computed for
+      size_t version;
+    }; // struct Structure
+
+  public:
+    CC lincomb(const std::vector< std::shared_ptr< const CC > >& containers, const std::vector< double >& evals) const
+    {
+      assert(containers.size() == evals.size());
+      assert(containers.size() > 0);
+      const auto merged_structure = structure(containers);
+      CC ret = merged_structure->merged->copy();
+      accumulate(*merged_structure, containers, evals, ret);
+      return ret;
+    }
+
+    void lincomb(const std::vector< std::shared_ptr< const CC > >& containers,
+                 const std::vector< double >& evals,
+                 CC& target) const
     {
       assert(containers.size() == evals.size());
       assert(containers.size() > 0);
-      Stuff::LA::SparsityPatternDefault merged_pattern(containers[0]->rows());
-      for (size_t qq = 0; qq < containers.size(); ++qq) {
-        auto pattern = containers[qq]->pattern();
-        for (size_t ii = 0; ii < pattern.size(); ++ii)
-          for (const size_t& jj : pattern.inner(ii))
-            merged_pattern.insert(ii, jj);
+      const auto merged_structure = structure(containers);
+      const auto& merged = *merged_structure->merged;
+      if (target.rows() != merged.rows() || target.cols() != merged.cols()
+          || target.backend().nonzeroes() != merged.backend().nonzeroes())
+        target = merged.copy();
+      assert(merged_structure->has_pattern_of(target));
+      accumulate(*merged_structure, containers, evals, target);
+    }
+
+    /**
+     * \brief Marks the cached structure as outdated, to be called whenever the pattern of a container may change.
+     */
+    void invalidate() const
+    {
+      ++version_;
+    }
+
+  private:
+    std::shared_ptr< const Structure > structure(const std::vector< std::shared_ptr< const CC > >& containers) const
+    {
+      const size_t version = version_.load();
+      auto current = std::atomic_load(&structure_);
+      if (!current || current->version != version) {
+        std::lock_guard< std::mutex > lock(mutex_);
+        current = std::atomic_load(&structure_);
+        if (!current || current->version != version) {
+          current = std::make_shared< const Structure >(containers, version);
+          std::atomic_store(&structure_, current);
+        }
       }
-      merged_pattern.sort();
-      Stuff::LA::IstlRowMajorSparseMatrix< SS > ret(containers[0]->rows(), containers[0]->cols(), merged_pattern);
-      for (size_t ii = 0; ii < ret.rows(); ++ii) {
-        auto& row = ret.backend()[ii];
-        row *= SS(0);
+      assert(current->matches(containers));
+      return current;
+    } // ... structure(...)
+
+    static void accumulate(const Structure& merged_structure,
+                           const std::vector< std::shared_ptr< const CC > >& containers,
+                           const std::vector< double >& evals,
+                           CC& target)
+    {
+      auto& target_backend = target.backend();
+      std::vector< size_t > cursors(containers.size(), 0);
+      for (size_t ii = 0; ii < target_backend.N(); ++ii) {
+        if (target_backend.getrowsize(ii) == 0)
+          continue;
+        auto& row = target_backend[ii];
+        auto* values = &(*row.begin());
+        for (size_t kk = 0; kk < row.size(); ++kk)
+          values[kk] = SS(0);
         for (size_t qq = 0; qq < containers.size(); ++qq) {
           const auto& other = containers[qq]->backend();
-          if (other.getrowsize(ii) > 0) {
-            const auto& other_row = other[ii];
-            const auto it_end = other_row.end();
-            for (auto it = other_row.begin(); it != it_end; ++it) {
-              const auto jj = it.index();
-              const auto& val = *it;
-              row[jj][0][0] += val*evals[qq];
-            }
-          }
+          if (other.getrowsize(ii) == 0)
+            continue;
+          const auto& positions = merged_structure.positions[qq];
+          size_t& cursor = cursors[qq];
+          const auto other_row_end = other[ii].end();
+          for (auto it = other[ii].begin(); it != other_row_end; ++it, ++cursor)
+            values[positions[cursor]][0][0] += evals[qq] * (*it)[0][0];
         }
       }
-      return ret;
-    }
-  }; // struct Assemble< Stuff::LA::IstlRowMajorSparseMatrix< ... > >
+    } // ... accumulate(...)
+
+    //! only serializes the computation of a new structure, assembling with a valid structure does not lock
+    mutable std::mutex mutex_;
+    mutable std::shared_ptr< const Structure > structure_;
+    mutable std::atomic< size_t > version_{0};
+  }; // class Assembler< Stuff::LA::IstlRowMajorSparseMatrix< ... > >
 
 #endif // HAVE_DUNE_ISTL
 
@@ -349,7 +609,13 @@ protected:
   DUNE_STUFF_SSIZE_T num_components_;
   std::vector< std::shared_ptr< const ContainerType > > components_;
   std::vector< std::shared_ptr< const ParameterFunctional > > coefficients_;
+  std::vector< size_t > projections_;
   std::shared_ptr< const ContainerType > affinePart_;
+  //! the affine part (if any) followed by all components, in the order expected by collect()
+  std::vector< std::shared_ptr< const ContainerType > > containers_;
+  //! the largest dimension of the parameter of any coefficient
+  size_t scratch_size_ = 0;
+  std::shared_ptr< const Assembler< ContainerType > > assembler_ = std::make_shared< Assembler< ContainerType > >();
 }; // class AffinelyDecomposedConstContainer
 
 
@@ -534,16 +800,23 @@ public:
     return BaseType::register_component(comp_ptr, coeff_ptr);
   }
 
+  /**
+   * \note The pattern of the returned container may be changed until the next call to freeze_parameter().
+   */
   std::shared_ptr< ContainerType > affine_part() const
   {
     if (!BaseType::has_affine_part())
       DUNE_THROW(Stuff::Exceptions::requirements_not_met,
                  "do not call affine_part() if has_affine_part() == false!");
+    this->assembler_->invalidate();
     return writableAffinePart_;
   }
 
   using BaseType::component;
 
+  /**
+   * \note The pattern of the returned container may be changed until the next call to freeze_parameter().
+   */
   std::shared_ptr< ContainerType > component(const DUNE_STUFF_SSIZE_T qq)
   {
     if (BaseType::num_components() == 0)
@@ -553,6 +826,7 @@ public:
       DUNE_THROW(Stuff::Exceptions::index_out_of_range,
                  "the condition 0 < " << qq << " < num_components() = " << BaseType::num_components()
                             << " is not satisfied!");
+    this->assembler_->invalidate();
     return writableComponents_[qq];
   }
 
@@ -0,0 +1,457 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_CONTAINER_LINCOMB_HH
+#define DUNE_PYMOR_LA_CONTAINER_LINCOMB_HH
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Computes target = sum_q thetas[q] * sources[q] in one pass.
+ *
+ *        The entries are processed in blocks small enough to stay in the L1 cache, such that each source is read
+ *        once and target is written once, instead of one sweep over target per source. Two sources are accumulated
+ *        at a time, the inner loops are simple enough to be vectorized by the compiler.
+ */
+template< class ScalarType >
+void fused_lincomb(const std::vector< const ScalarType* >& sources,
+                   const std::vector< double >& thetas,
+                   const size_t size,
+                   ScalarType* target)
+{
+  static const size_t block_size = 512;
+  assert(sources.size() == thetas.size());
+  assert(sources.size() > 0);
+  const size_t num_sources = sources.size();
+  for (size_t begin = 0; begin < size; begin += block_size) {
+    const size_t nn = std::min(block_size, size - begin);
+    ScalarType* tt = target + begin;
+    const ScalarType* s0 = sources[0] + begin;
+    const ScalarType t0 = thetas[0];
+    for (size_t ii = 0; ii < nn; ++ii)
+      tt[ii] = t0 * s0[ii];
+    size_t qq = 1;
+    for (; qq + 1 < num_sources; qq += 2) {
+      const ScalarType* s1 = sources[qq] + begin;
+      const ScalarType* s2 = sources[qq + 1] + begin;
+      const ScalarType t1 = thetas[qq];
+      const ScalarType t2 = thetas[qq + 1];
+      for (size_t ii = 0; ii < nn; ++ii)
+        tt[ii] += t1 * s1[ii] + t2 * s2[ii];
+    }
+    if (qq < num_sources) {
+      const ScalarType* s1 = sources[qq] + begin;
+      const ScalarType t1 = thetas[qq];
+      for (size_t ii = 0; ii < nn; ++ii)
+        tt[ii] += t1 * s1[ii];
+    }
+  }
+} // ... fused_lincomb(...)
+
+
+/**
+ * \brief Computes C = V^T W, where the N columns of V and the M columns of W (each of length n) are stored
+ *        contiguously one after the other and C is stored row-major.
+ *
+ *        The columns are processed in blocks of rows small enough that one tile of columns of V and W stays in the L1
+ *        cache. For each row, the micro-kernel loads one entry of each of the 4 columns of V and W of a tile and
+ *        updates all 4 x 4 entries of the tile of C (held in local variables) with them, such that each load is reused
+ *        four times. The tiles at the border of C fall back to plain dot products.
+ */
+template< class ScalarType >
+void gemm_tn(const size_t n, const size_t N, const size_t M, const ScalarType* V, const ScalarType* W, ScalarType* C)
+{
+  static const size_t block_size = 256;
+  static const size_t tile_size = 4;
+  std::fill(C, C + N * M, ScalarType(0));
+  for (size_t k_begin = 0; k_begin < n; k_begin += block_size) {
+    const size_t k_end = std::min(n, k_begin + block_size);
+    for (size_t i_begin = 0; i_begin < N; i_begin += tile_size) {
+      const size_t i_end = std::min(N, i_begin + tile_size);
+      for (size_t j_begin = 0; j_begin < M; j_begin += tile_size) {
+        const size_t j_end = std::min(M, j_begin + tile_size);
+        ScalarType tile[tile_size][tile_size] = {};
+        if (i_end - i_begin == tile_size && j_end - j_begin == tile_size) {
+          for (size_t kk = k_begin; kk < k_end; ++kk) {
+            ScalarType vv[tile_size];
+            ScalarType ww[tile_size];
+            for (size_t aa = 0; aa < tile_size; ++aa) {
+              vv[aa] = V[(i_begin + aa) * n + kk];
+              ww[aa] = W[(j_begin + aa) * n + kk];
+            }
+            for (size_t aa = 0; aa < tile_size; ++aa)
+              for (size_t bb = 0; bb < tile_size; ++bb)
+                tile[aa][bb] += vv[aa] * ww[bb];
+          }
+        } else {
+          for (size_t ii = i_begin; ii < i_end; ++ii) {
+            const ScalarType* vv = V + ii * n;
+            for (size_t jj = j_begin; jj < j_end; ++jj) {
+              const ScalarType* ww = W + jj * n;
+              ScalarType sum = 0;
+              for (size_t kk = k_begin; kk < k_end; ++kk)
+                sum += vv[kk] * ww[kk];
+              tile[ii - i_begin][jj - j_begin] = sum;
+            }
+          }
+        }
+        for (size_t ii = i_begin; ii < i_end; ++ii)
+          for (size_t jj = j_begin; jj < j_end; ++jj)
+            C[ii * M + jj] += tile[ii - i_begin][jj - j_begin];
+      }
+    }
+  }
+} // ... gemm_tn(...)
+
+
+/**
+ * \brief Gives access to the storage of a dense container as a number of contiguous chunks of equal size.
+ *
+ *        Specializations have to provide available = true, the methods num_chunks(), chunk_size() and chunk() (const
+ *        and non-const) and create(), which returns a container of the same shape (the dune-stuff containers are zero
+ *        initialized on construction, all entries are overwritten by Lincomb anyway). Read access to the
+ *        sources uses the const backend() only, which does not trigger a deep copy of shared containers.
+ */
+template< class ContainerType >
+struct DenseAccess
+{
+  static const bool available = false;
+};
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::CommonDenseVector< S > >
+{
+  typedef Stuff::LA::CommonDenseVector< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.size(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/)
+  {
+    return &(container.backend()[0]);
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return &(container.backend()[0]); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.size()); }
+}; // struct DenseAccess< Stuff::LA::CommonDenseVector< ... > >
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::CommonDenseMatrix< S > >
+{
+  typedef Stuff::LA::CommonDenseMatrix< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& container) { return container.rows(); }
+
+  static size_t chunk_size(const ContainerType& container) { return container.cols(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t ii)
+  {
+    return &(container.backend()[ii][0]);
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t ii) { return &(container.backend()[ii][0]); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.rows(), like.cols()); }
+}; // struct DenseAccess< Stuff::LA::CommonDenseMatrix< ... > >
+
+
+#if HAVE_EIGEN
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::EigenDenseVector< S > >
+{
+  typedef Stuff::LA::EigenDenseVector< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.size(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/)
+  {
+    return container.backend().data();
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return container.backend().data(); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.size()); }
+}; // struct DenseAccess< Stuff::LA::EigenDenseVector< ... > >
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::EigenMappedDenseVector< S > >
+{
+  typedef Stuff::LA::EigenMappedDenseVector< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.size(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/)
+  {
+    return container.backend().data();
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return container.backend().data(); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.size()); }
+}; // struct DenseAccess< Stuff::LA::EigenMappedDenseVector< ... > >
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::EigenDenseMatrix< S > >
+{
+  typedef Stuff::LA::EigenDenseMatrix< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.rows() * container.cols(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/)
+  {
+    return container.backend().data();
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return container.backend().data(); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.rows(), like.cols()); }
+}; // struct DenseAccess< Stuff::LA::EigenDenseMatrix< ... > >
+
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+
+template< class S >
+struct DenseAccess< Stuff::LA::IstlDenseVector< S > >
+{
+  typedef Stuff::LA::IstlDenseVector< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.size(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/)
+  {
+    return &(container.backend()[0][0]);
+  }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return &(container.backend()[0][0]); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.size()); }
+}; // struct DenseAccess< Stuff::LA::IstlDenseVector< ... > >
+
+
+#endif // HAVE_DUNE_ISTL
+
+
+/**
+ * \brief Copies the entries of vector to target, directly from the storage for the dense containers of dune-stuff.
+ */
+template< class VectorType, bool dense = DenseAccess< VectorType >::available >
+struct Pack
+{
+  static void apply(const VectorType& vector, typename VectorType::ScalarType* target)
+  {
+    const size_t size = vector.size();
+    for (size_t ii = 0; ii < size; ++ii)
+      target[ii] = vector.get_entry(ii);
+  }
+}; // struct Pack
+
+
+template< class VectorType >
+struct Pack< VectorType, true >
+{
+  typedef DenseAccess< VectorType > AccessType;
+
+  static void apply(const VectorType& vector, typename VectorType::ScalarType* target)
+  {
+    if (vector.size() == 0)
+      return;
+    const size_t chunk_size = AccessType::chunk_size(vector);
+    for (size_t ii = 0; ii < AccessType::num_chunks(vector); ++ii)
+      std::memcpy(target + ii * chunk_size, AccessType::chunk(vector, ii), chunk_size * sizeof(*target));
+  }
+}; // struct Pack< ..., true >
+
+
+template< class VectorType >
+void pack(const VectorType& vector, typename VectorType::ScalarType* target)
+{
+  Pack< VectorType >::apply(vector, target);
+}
+
+
+/**
+ * \brief Copies the entries of source to vector, directly to the storage for the dense containers of dune-stuff.
+ */
+template< class VectorType, bool dense = DenseAccess< VectorType >::available >
+struct Unpack
+{
+  static void apply(const typename VectorType::ScalarType* source, VectorType& vector)
+  {
+    const size_t size = vector.size();
+    for (size_t ii = 0; ii < size; ++ii)
+      vector.set_entry(ii, source[ii]);
+  }
+}; // struct Unpack
+
+
+template< class VectorType >
+struct Unpack< VectorType, true >
+{
+  typedef DenseAccess< VectorType > AccessType;
+
+  static void apply(const typename VectorType::ScalarType* source, VectorType& vector)
+  {
+    if (vector.size() == 0)
+      return;
+    const size_t chunk_size = AccessType::chunk_size(vector);
+    for (size_t ii = 0; ii < AccessType::num_chunks(vector); ++ii)
+      std::memcpy(AccessType::chunk(vector, ii), source + ii * chunk_size, chunk_size * sizeof(*source));
+  }
+}; // struct Unpack< ..., true >
+
+
+template< class VectorType >
+void unpack(const typename VectorType::ScalarType* source, VectorType& vector)
+{
+  Unpack< VectorType >::apply(source, vector);
+}
+
+
+template< class ContainerType, bool dense = DenseAccess< ContainerType >::available >
+struct Lincomb
+{
+  static ContainerType create(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+                              const std::vector< double >& thetas)
+  {
+    auto ret = containers[0]->copy();
+    ret.scal(thetas[0]);
+    for (size_t qq = 1; qq < containers.size(); ++qq)
+      ret.axpy(thetas[qq], *containers[qq]);
+    return ret;
+  }
+
+  static void apply(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+                    const std::vector< double >& thetas,
+                    ContainerType& target)
+  {
+    target.scal(0.);
+    for (size_t qq = 0; qq < containers.size(); ++qq)
+      target.axpy(thetas[qq], *containers[qq]);
+  }
+}; // struct Lincomb
+
+
+template< class ContainerType >
+struct Lincomb< ContainerType, true >
+{
+  typedef DenseAccess< ContainerType > AccessType;
+  typedef typename AccessType::ScalarType ScalarType;
+
+  static ContainerType create(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+                              const std::vector< double >& thetas)
+  {
+    auto ret = AccessType::create(*containers[0]);
+    apply(containers, thetas, ret);
+    return ret;
+  }
+
+  static void apply(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+                    const std::vector< double >& thetas,
+                    ContainerType& target)
+  {
+    const size_t num_chunks = AccessType::num_chunks(target);
+    const size_t chunk_size = AccessType::chunk_size(target);
+    if (chunk_size == 0)
+      return;
+    std::vector< const ScalarType* > sources(containers.size(), nullptr);
+    for (size_t ii = 0; ii < num_chunks; ++ii) {
+      for (size_t qq = 0; qq < containers.size(); ++qq)
+        sources[qq] = AccessType::chunk(*containers[qq], ii);
+      fused_lincomb(sources, thetas, chunk_size, AccessType::chunk(target, ii));
+    }
+  }
+}; // struct Lincomb< ..., true >
+
+
+} // namespace internal
+
+
+/**
+ * \brief Returns sum_q thetas[q] * (*containers[q]).
+ *
+ *        For the dense containers of dune-stuff this is a single cache-blocked pass over all containers, any other
+ *        container is assembled by copy(), scal() and axpy().
+ */
+template< class ContainerType >
+ContainerType lincomb(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+                      const std::vector< double >& thetas)
+{
+  if (containers.size() != thetas.size())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of containers (" << containers.size() << ") has to equal the size of thetas ("
+               << thetas.size() << ")!");
+  if (containers.empty())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "containers must not be empty!");
+  return internal::Lincomb< ContainerType >::create(containers, thetas);
+}
+
+/**
+ * \brief Computes target = sum_q thetas[q] * (*containers[q]), target has to be of the same shape as the containers.
+ */
+template< class ContainerType >
+void lincomb(const std::vector< std::shared_ptr< const ContainerType > >& containers,
+             const std::vector< double >& thetas,
+             ContainerType& target)
+{
+  if (containers.size() != thetas.size())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of containers (" << containers.size() << ") has to equal the size of thetas ("
+               << thetas.size() << ")!");
+  if (containers.empty())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "containers must not be empty!");
+  if (!target.has_equal_shape(*containers[0]))
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match, "the shape of target does not match the shape of containers!");
+  internal::Lincomb< ContainerType >::apply(containers, thetas, target);
+}
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_CONTAINER_LINCOMB_HH
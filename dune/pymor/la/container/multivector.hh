@@ -0,0 +1,589 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_CONTAINER_MULTIVECTOR_HH
+#define DUNE_PYMOR_LA_CONTAINER_MULTIVECTOR_HH
+
+#include <cmath>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container.hh>
+
+#include "lincomb.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace Tags {
+
+
+class MultiVectorInterface {};
+
+
+} // namespace Tags
+namespace LA {
+
+
+/**
+ * \brief A sequence of len() vectors of length dim(), stored as one contiguous column-major dim() x len() block.
+ *
+ *        The vector ii occupies [column(ii), column(ii) + dim()). Products of two multi vectors (dot(), gramian()) and
+ *        linear combinations of the vectors (lincomb()) are computed by the blocked kernels of lincomb.hh. Appending
+ *        may reallocate the storage and thus invalidates all pointers obtained by data() or column().
+ */
+template< class ScalarImp = double >
+class MultiVector
+  : public Tags::MultiVectorInterface
+{
+public:
+  typedef ScalarImp                                  ScalarType;
+  typedef MultiVector< ScalarType >                  ThisType;
+  typedef Stuff::LA::CommonDenseMatrix< ScalarType > MatrixType;
+
+  static std::string type_this()
+  {
+    return "dune.pymor.la.container.multivector";
+  }
+
+  explicit MultiVector(const size_t dd = 0, const size_t ll = 0)
+    : dim_(dd)
+    , len_(ll)
+    , data_(dd * ll, ScalarType(0))
+  {}
+
+  size_t dim() const
+  {
+    return dim_;
+  }
+
+  size_t len() const
+  {
+    return len_;
+  }
+
+  void reserve(const size_t ll)
+  {
+    data_.reserve(ll * dim_);
+  }
+
+  ScalarType* data()
+  {
+    return data_.data();
+  }
+
+  const ScalarType* data() const
+  {
+    return data_.data();
+  }
+
+  ScalarType* column(const size_t ii)
+  {
+    assert(ii < len_);
+    return data_.data() + ii * dim_;
+  }
+
+  const ScalarType* column(const size_t ii) const
+  {
+    assert(ii < len_);
+    return data_.data() + ii * dim_;
+  }
+
+  /**
+   * \brief Copies the vector ii to vector, which has to be of size dim().
+   */
+  template< class VectorType >
+  void get(const size_t ii, VectorType& vector) const
+  {
+    check_index(ii);
+    if (vector.size() != dim_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of vector (" << vector.size() << ") does not match dim() (" << dim_ << ")!");
+    internal::unpack(column(ii), vector);
+  }
+
+  template< class VectorType >
+  void set(const size_t ii, const VectorType& vector)
+  {
+    check_index(ii);
+    if (vector.size() != dim_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of vector (" << vector.size() << ") does not match dim() (" << dim_ << ")!");
+    internal::pack(vector, column(ii));
+  }
+
+  template< class VectorType >
+  void append(const VectorType& vector)
+  {
+    if (vector.size() != dim_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of vector (" << vector.size() << ") does not match dim() (" << dim_ << ")!");
+    data_.resize(data_.size() + dim_);
+    ++len_;
+    internal::pack(vector, column(len_ - 1));
+  }
+
+  void append(const ThisType& other)
+  {
+    check_dim(other);
+    if (&other == this) {
+      const ThisType tmp(other);
+      append(tmp);
+      return;
+    }
+    data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+    len_ += other.len_;
+  }
+
+  void append(const ThisType& other, const std::vector< size_t >& indices)
+  {
+    check_dim(other);
+    if (&other == this) {
+      const ThisType tmp(other);
+      append(tmp, indices);
+      return;
+    }
+    for (const size_t ii : indices)
+      other.check_index(ii);
+    data_.reserve(data_.size() + indices.size() * dim_);
+    for (const size_t ii : indices)
+      data_.insert(data_.end(), other.column(ii), other.column(ii) + dim_);
+    len_ += indices.size();
+  }
+
+  ThisType copy() const
+  {
+    return *this;
+  }
+
+  ThisType copy(const std::vector< size_t >& indices) const
+  {
+    ThisType ret(dim_);
+    ret.append(*this, indices);
+    return ret;
+  }
+
+  /**
+   * \brief Removes the vectors given by indices, keeps the order of the remaining ones.
+   */
+  void remove(const std::vector< size_t >& indices)
+  {
+    std::vector< bool > removed(len_, false);
+    for (const size_t ii : indices) {
+      check_index(ii);
+      removed[ii] = true;
+    }
+    size_t target = 0;
+    for (size_t ii = 0; ii < len_; ++ii) {
+      if (removed[ii])
+        continue;
+      if (target != ii)
+        std::copy(column(ii), column(ii) + dim_, column(target));
+      ++target;
+    }
+    len_ = target;
+    data_.resize(len_ * dim_);
+  } // ... remove(...)
+
+  void scal(const ScalarType& alpha)
+  {
+    for (auto& value : data_)
+      value *= alpha;
+  }
+
+  //! scales the vector ii by alphas[ii]
+  void scal(const std::vector< ScalarType >& alphas)
+  {
+    check_len(alphas.size());
+    for (size_t ii = 0; ii < len_; ++ii) {
+      ScalarType* vv = column(ii);
+      for (size_t kk = 0; kk < dim_; ++kk)
+        vv[kk] *= alphas[ii];
+    }
+  }
+
+  /**
+   * \brief Adds alpha times the vector ii of xx to the vector ii, xx may also consist of a single vector only, which
+   *        is then added to all vectors.
+   */
+  void axpy(const ScalarType& alpha, const ThisType& xx)
+  {
+    axpy(std::vector< ScalarType >(len_, alpha), xx);
+  }
+
+  void axpy(const std::vector< ScalarType >& alphas, const ThisType& xx)
+  {
+    check_dim(xx);
+    check_len(alphas.size());
+    if (xx.len_ != len_ && xx.len_ != 1)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "xx has to consist of len() (" << len_ << ") or one vector(s) (is " << xx.len_ << ")!");
+    for (size_t ii = 0; ii < len_; ++ii) {
+      ScalarType* yy = column(ii);
+      const ScalarType* xx_ii = xx.column(xx.len_ == 1 ? 0 : ii);
+      const ScalarType alpha = alphas[ii];
+      for (size_t kk = 0; kk < dim_; ++kk)
+        yy[kk] += alpha * xx_ii[kk];
+    }
+  } // ... axpy(...)
+
+  /**
+   * \brief Returns the len() x other.len() matrix of the scalar products of the vectors of this and of other.
+   */
+  MatrixType dot(const ThisType& other) const
+  {
+    const auto products = pb_dot(other);
+    return to_matrix(products.data(), len_, other.len_);
+  }
+
+  std::vector< ScalarType > pairwise_dot(const ThisType& other) const
+  {
+    check_dim(other);
+    check_len(other.len_);
+    std::vector< ScalarType > ret(len_, ScalarType(0));
+    for (size_t ii = 0; ii < len_; ++ii) {
+      const ScalarType* vv = column(ii);
+      const ScalarType* ww = other.column(ii);
+      for (size_t kk = 0; kk < dim_; ++kk)
+        ret[ii] += vv[kk] * ww[kk];
+    }
+    return ret;
+  } // ... pairwise_dot(...)
+
+  MatrixType gramian() const
+  {
+    return dot(*this);
+  }
+
+  /**
+   * \brief Returns the coefficients.rows() linear combinations sum_j coefficients[i][j] v_j of the vectors v_j.
+   */
+  ThisType lincomb(const MatrixType& coefficients) const
+  {
+    if (size_t(coefficients.cols()) != len_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the number of columns of coefficients (" << coefficients.cols() << ") does not match len() ("
+                 << len_ << ")!");
+    const size_t num = coefficients.rows();
+    ThisType ret(dim_, num);
+    if (len_ == 0 || dim_ == 0)
+      return ret;
+    std::vector< const ScalarType* > sources(len_);
+    for (size_t jj = 0; jj < len_; ++jj)
+      sources[jj] = column(jj);
+    std::vector< double > thetas(len_);
+    for (size_t ii = 0; ii < num; ++ii) {
+      for (size_t jj = 0; jj < len_; ++jj)
+        thetas[jj] = coefficients.get_entry(ii, jj);
+      internal::fused_lincomb(sources, thetas, dim_, ret.column(ii));
+    }
+    return ret;
+  } // ... lincomb(...)
+
+  ThisType lincomb(const std::vector< ScalarType >& coefficients) const
+  {
+    MatrixType matrix(1, coefficients.size());
+    for (size_t jj = 0; jj < coefficients.size(); ++jj)
+      matrix.set_entry(0, jj, coefficients[jj]);
+    return lincomb(matrix);
+  }
+
+  std::vector< ScalarType > l1_norm() const
+  {
+    std::vector< ScalarType > ret(len_, ScalarType(0));
+    for (size_t ii = 0; ii < len_; ++ii) {
+      const ScalarType* vv = column(ii);
+      for (size_t kk = 0; kk < dim_; ++kk)
+        ret[ii] += std::abs(vv[kk]);
+    }
+    return ret;
+  }
+
+  std::vector< ScalarType > l2_norm() const
+  {
+    auto ret = pairwise_dot(*this);
+    for (auto& value : ret)
+      value = std::sqrt(value);
+    return ret;
+  }
+
+  std::vector< ScalarType > sup_norm() const
+  {
+    std::vector< ScalarType > ret(len_, ScalarType(0));
+    for (size_t ii = 0; ii < len_; ++ii) {
+      const ScalarType* vv = column(ii);
+      for (size_t kk = 0; kk < dim_; ++kk)
+        ret[ii] = std::max(ret[ii], std::abs(vv[kk]));
+    }
+    return ret;
+  }
+
+  //! \name methods for the python bindings, which only support DUNE_STUFF_SSIZE_T indices
+  //! \{
+  DUNE_STUFF_SSIZE_T pb_dim() const
+  {
+    return dim_;
+  }
+
+  DUNE_STUFF_SSIZE_T pb_len() const
+  {
+    return len_;
+  }
+
+  void pb_append(const ThisType& other, const std::vector< DUNE_STUFF_SSIZE_T >& indices)
+  {
+    append(other, to_indices(indices));
+  }
+
+  ThisType pb_copy(const std::vector< DUNE_STUFF_SSIZE_T >& indices) const
+  {
+    return copy(to_indices(indices));
+  }
+
+  void pb_remove(const std::vector< DUNE_STUFF_SSIZE_T >& indices)
+  {
+    remove(to_indices(indices));
+  }
+
+  /**
+   * \brief Returns the products of dot() as a multi vector, the vector ii of which holds the row ii of dot().
+   *
+   *        Thus the (row-major) products can be handed to python via the buffer protocol without copying them.
+   */
+  ThisType pb_dot(const ThisType& other) const
+  {
+    check_dim(other);
+    ThisType ret(other.len_, len_);
+    if (len_ > 0 && other.len_ > 0)
+      internal::gemm_tn(dim_, len_, other.len_, data(), other.data(), ret.data());
+    return ret;
+  }
+
+  ThisType pb_gramian() const
+  {
+    return pb_dot(*this);
+  }
+
+  //! coefficients are the row-major entries of a num x len() matrix, see lincomb()
+  ThisType pb_lincomb(const std::vector< ScalarType >& coefficients, const DUNE_STUFF_SSIZE_T num) const
+  {
+    if (num < 0 || coefficients.size() != size_t(num) * len_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "coefficients (of size " << coefficients.size() << ") has to hold num x len() (" << num << " x "
+                 << len_ << ") entries!");
+    return lincomb(to_matrix(coefficients.data(), num, len_));
+  }
+  //! \}
+
+private:
+  static std::vector< size_t > to_indices(const std::vector< DUNE_STUFF_SSIZE_T >& indices)
+  {
+    std::vector< size_t > ret(indices.size());
+    for (size_t ii = 0; ii < indices.size(); ++ii) {
+      if (indices[ii] < 0)
+        DUNE_THROW(Stuff::Exceptions::index_out_of_range, "indices must not be negative (is " << indices[ii] << ")!");
+      ret[ii] = size_t(indices[ii]);
+    }
+    return ret;
+  }
+
+  static MatrixType to_matrix(const ScalarType* values, const size_t rows, const size_t cols)
+  {
+    MatrixType ret(rows, cols);
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        ret.set_entry(ii, jj, values[ii * cols + jj]);
+    return ret;
+  }
+
+  void check_index(const size_t ii) const
+  {
+    if (ii >= len_)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range, "ii (" << ii << ") has to be smaller than len() (" << len_
+                 << ")!");
+  }
+
+  void check_len(const size_t ll) const
+  {
+    if (ll != len_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the given length (" << ll << ") does not match len() (" << len_ << ")!");
+  }
+
+  void check_dim(const ThisType& other) const
+  {
+    if (other.dim_ != dim_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim() of other (" << other.dim_ << ") does not match dim() (" << dim_ << ")!");
+  }
+
+  size_t dim_;
+  size_t len_;
+  std::vector< ScalarType > data_;
+}; // class MultiVector
+
+
+namespace internal {
+
+
+template< class S >
+struct DenseAccess< MultiVector< S > >
+{
+  typedef MultiVector< S > ContainerType;
+  typedef S ScalarType;
+  static const bool available = true;
+
+  static size_t num_chunks(const ContainerType& /*container*/) { return 1; }
+
+  static size_t chunk_size(const ContainerType& container) { return container.dim() * container.len(); }
+
+  static const ScalarType* chunk(const ContainerType& container, const size_t /*ii*/) { return container.data(); }
+
+  static ScalarType* chunk(ContainerType& container, const size_t /*ii*/) { return container.data(); }
+
+  static ContainerType create(const ContainerType& like) { return ContainerType(like.dim(), like.len()); }
+}; // struct DenseAccess< MultiVector< ... > >
+
+
+/**
+ * \brief Computes ranges = matrix * sources for all vectors of sources at once.
+ *
+ *        The default calls matrix.mv() for each vector, going through a VectorType. The specializations for the
+ *        matrices of dune-stuff instead traverse the matrix only once for all vectors, i.e., they compute one
+ *        (sparse) matrix-matrix product instead of sources.len() matrix-vector products. The shapes are not checked.
+ */
+template< class MatrixType, class VectorType >
+struct BlockMv
+{
+  typedef typename MatrixType::ScalarType ScalarType;
+
+  static void apply(const MatrixType& matrix,
+                    const MultiVector< ScalarType >& sources,
+                    MultiVector< ScalarType >& ranges)
+  {
+    VectorType source(sources.dim());
+    VectorType range(ranges.dim());
+    for (size_t ii = 0; ii < sources.len(); ++ii) {
+      sources.get(ii, source);
+      matrix.mv(source, range);
+      ranges.set(ii, range);
+    }
+  }
+}; // struct BlockMv
+
+
+template< class S, class VectorType >
+struct BlockMv< Stuff::LA::CommonDenseMatrix< S >, VectorType >
+{
+  static void apply(const Stuff::LA::CommonDenseMatrix< S >& matrix,
+                    const MultiVector< S >& sources,
+                    MultiVector< S >& ranges)
+  {
+    const auto& backend = matrix.backend();
+    const size_t rows = ranges.dim();
+    const size_t cols = sources.dim();
+    if (cols == 0) {
+      std::fill(ranges.data(), ranges.data() + rows * ranges.len(), S(0));
+      return;
+    }
+    // each row of the matrix is loaded once and multiplied with all sources
+    for (size_t ii = 0; ii < rows; ++ii) {
+      const S* row = &(backend[ii][0]);
+      for (size_t jj = 0; jj < sources.len(); ++jj) {
+        const S* source = sources.column(jj);
+        S sum(0);
+        for (size_t kk = 0; kk < cols; ++kk)
+          sum += row[kk] * source[kk];
+        ranges.column(jj)[ii] = sum;
+      }
+    }
+  } // ... apply(...)
+}; // struct BlockMv< Stuff::LA::CommonDenseMatrix< ... >, ... >
+
+
+#if HAVE_EIGEN
+
+
+template< class BackendType, class S >
+void eigen_block_mv(const BackendType& backend, const MultiVector< S >& sources, MultiVector< S >& ranges)
+{
+  typedef ::Eigen::Matrix< S, ::Eigen::Dynamic, ::Eigen::Dynamic, ::Eigen::ColMajor > BlockType;
+  const ::Eigen::Map< const BlockType > source_block(sources.data(), sources.dim(), sources.len());
+  ::Eigen::Map< BlockType > range_block(ranges.data(), ranges.dim(), ranges.len());
+  range_block.noalias() = backend * source_block;
+}
+
+
+template< class S, class VectorType >
+struct BlockMv< Stuff::LA::EigenDenseMatrix< S >, VectorType >
+{
+  static void apply(const Stuff::LA::EigenDenseMatrix< S >& matrix,
+                    const MultiVector< S >& sources,
+                    MultiVector< S >& ranges)
+  {
+    eigen_block_mv(matrix.backend(), sources, ranges);
+  }
+}; // struct BlockMv< Stuff::LA::EigenDenseMatrix< ... >, ... >
+
+
+template< class S, class VectorType >
+struct BlockMv< Stuff::LA::EigenRowMajorSparseMatrix< S >, VectorType >
+{
+  static void apply(const Stuff::LA::EigenRowMajorSparseMatrix< S >& matrix,
+                    const MultiVector< S >& sources,
+                    MultiVector< S >& ranges)
+  {
+    eigen_block_mv(matrix.backend(), sources, ranges);
+  }
+}; // struct BlockMv< Stuff::LA::EigenRowMajorSparseMatrix< ... >, ... >
+
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+
+template< class S, class VectorType >
+struct BlockMv< Stuff::LA::IstlRowMajorSparseMatrix< S >, VectorType >
+{
+  static void apply(const Stuff::LA::IstlRowMajorSparseMatrix< S >& matrix,
+                    const MultiVector< S >& sources,
+                    MultiVector< S >& ranges)
+  {
+    const auto& backend = matrix.backend();
+    const size_t len = sources.len();
+    const size_t source_dim = sources.dim();
+    const size_t range_dim = ranges.dim();
+    const S* source_data = sources.data();
+    S* range_data = ranges.data();
+    // each entry of the matrix is loaded once and applied to all sources, the row ii of all ranges is accumulated
+    // contiguously and written (strided) once
+    std::vector< S > row(len);
+    for (size_t ii = 0; ii < backend.N(); ++ii) {
+      std::fill(row.begin(), row.end(), S(0));
+      const auto row_end = backend[ii].end();
+      for (auto it = backend[ii].begin(); it != row_end; ++it) {
+        const S value = (*it)[0][0];
+        const S* source = source_data + it.index();
+        for (size_t jj = 0; jj < len; ++jj)
+          row[jj] += value * source[jj * source_dim];
+      }
+      for (size_t jj = 0; jj < len; ++jj)
+        range_data[jj * range_dim + ii] = row[jj];
+    }
+  } // ... apply(...)
+}; // struct BlockMv< Stuff::LA::IstlRowMajorSparseMatrix< ... >, ... >
+
+
+#endif // HAVE_DUNE_ISTL
+
+
+} // namespace internal
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_CONTAINER_MULTIVECTOR_HH
@@ -0,0 +1,222 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_FACTORIZATION_HH
+#define DUNE_PYMOR_LA_FACTORIZATION_HH
+
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <string>
+
+#if HAVE_EIGEN
+# include <Eigen/Dense>
+# include <Eigen/SparseCore>
+# include <Eigen/SparseLU>
+# include <Eigen/SparseCholesky>
+#endif
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+template< class VectorType >
+class FactorizationInterface
+{
+public:
+  virtual ~FactorizationInterface() {}
+
+  virtual void solve(const VectorType& rhs, VectorType& solution) const = 0;
+}; // class FactorizationInterface
+
+
+/**
+ * \brief Creates a factorization of a matrix, which can be applied to any number of right hand sides.
+ *
+ *        Specializations have to provide create(matrix, type), which returns nullptr if the solver type given by type
+ *        is not a direct solver that can be retained for the respective matrix, and throw
+ *        Stuff::Exceptions::linear_solver_failed if the matrix cannot be factorized.
+ */
+template< class MatrixType, class VectorType >
+struct Factorization
+{
+  static std::unique_ptr< const FactorizationInterface< VectorType > > create(const MatrixType& /*matrix*/,
+                                                                               const std::string& /*type*/)
+  {
+    return nullptr;
+  }
+}; // struct Factorization
+
+
+#if HAVE_EIGEN
+
+
+/**
+ * \brief Checks if decomposition succeeded, using info() (available for all but the dense LU decompositions).
+ */
+template< class DecompositionType >
+bool eigen_decomposition_succeeded(const DecompositionType& decomposition)
+{
+  return decomposition.info() == ::Eigen::Success;
+}
+
+template< class BackendType >
+bool eigen_decomposition_succeeded(const ::Eigen::FullPivLU< BackendType >& decomposition)
+{
+  return decomposition.isInvertible();
+}
+
+/**
+ * \brief Checks the diagonal of U, since PartialPivLU does not detect singular matrices itself.
+ */
+template< class BackendType >
+bool eigen_decomposition_succeeded(const ::Eigen::PartialPivLU< BackendType >& decomposition)
+{
+  const auto diagonal = decomposition.matrixLU().diagonal();
+  for (decltype(diagonal.size()) ii = 0; ii < diagonal.size(); ++ii)
+    if (!std::isfinite(std::abs(diagonal[ii])) || diagonal[ii] == typename BackendType::Scalar(0))
+      return false;
+  return true;
+} // ... eigen_decomposition_succeeded(...)
+
+
+template< class DecompositionType, class VectorType >
+class EigenFactorization
+  : public FactorizationInterface< VectorType >
+{
+public:
+  template< class BackendType >
+  explicit EigenFactorization(const BackendType& backend)
+    : decomposition_(backend)
+  {
+    if (!eigen_decomposition_succeeded(decomposition_))
+      DUNE_THROW(Stuff::Exceptions::linear_solver_failed,
+                 "the factorization of the matrix failed, the matrix is singular (or not positive definite)!");
+  }
+
+  void solve(const VectorType& rhs, VectorType& solution) const override final
+  {
+    solution.backend() = decomposition_.solve(rhs.backend());
+  }
+
+  const DecompositionType& decomposition() const
+  {
+    return decomposition_;
+  }
+
+private:
+  const DecompositionType decomposition_;
+}; // class EigenFactorization
+
+
+template< class S >
+struct Factorization< Stuff::LA::EigenDenseMatrix< S >, Stuff::LA::EigenDenseVector< S > >
+{
+  typedef Stuff::LA::EigenDenseVector< S > VectorType;
+  typedef typename Stuff::LA::EigenDenseMatrix< S >::BackendType BackendType;
+
+  static std::unique_ptr< const FactorizationInterface< VectorType > >
+  create(const Stuff::LA::EigenDenseMatrix< S >& matrix, const std::string& type)
+  {
+    typedef std::unique_ptr< const FactorizationInterface< VectorType > > ReturnType;
+    if (type == "lu.partialpiv")
+      return ReturnType(new EigenFactorization< ::Eigen::PartialPivLU< BackendType >, VectorType >(matrix.backend()));
+    else if (type == "lu.fullpiv")
+      return ReturnType(new EigenFactorization< ::Eigen::FullPivLU< BackendType >, VectorType >(matrix.backend()));
+    else if (type == "llt")
+      return ReturnType(new EigenFactorization< ::Eigen::LLT< BackendType >, VectorType >(matrix.backend()));
+    else if (type == "ldlt")
+      return ReturnType(new EigenFactorization< ::Eigen::LDLT< BackendType >, VectorType >(matrix.backend()));
+    return nullptr;
+  } // ... create(...)
+}; // struct Factorization< Stuff::LA::EigenDenseMatrix< ... >, ... >
+
+
+template< class S >
+struct Factorization< Stuff::LA::EigenRowMajorSparseMatrix< S >, Stuff::LA::EigenDenseVector< S > >
+{
+  typedef Stuff::LA::EigenDenseVector< S > VectorType;
+  typedef ::Eigen::SparseMatrix< S, ::Eigen::ColMajor > ColMajorBackendType;
+
+  static std::unique_ptr< const FactorizationInterface< VectorType > >
+  create(const Stuff::LA::EigenRowMajorSparseMatrix< S >& matrix, const std::string& type)
+  {
+    if (type == "lu.sparse")
+      return decompose< ::Eigen::SparseLU< ColMajorBackendType, ::Eigen::COLAMDOrdering< int > > >(matrix);
+    else if (type == "llt.simplicial")
+      return decompose< ::Eigen::SimplicialLLT< ColMajorBackendType > >(matrix);
+    else if (type == "ldlt.simplicial")
+      return decompose< ::Eigen::SimplicialLDLT< ColMajorBackendType > >(matrix);
+    return nullptr;
+  } // ... create(...)
+
+private:
+  template< class DecompositionType >
+  static std::unique_ptr< const FactorizationInterface< VectorType > >
+  decompose(const Stuff::LA::EigenRowMajorSparseMatrix< S >& matrix)
+  {
+    const ColMajorBackendType backend(matrix.backend());
+    return std::unique_ptr< const FactorizationInterface< VectorType > >(
+          new EigenFactorization< DecompositionType, VectorType >(backend));
+  } // ... decompose(...)
+}; // struct Factorization< Stuff::LA::EigenRowMajorSparseMatrix< ... >, ... >
+
+
+#endif // HAVE_EIGEN
+
+
+} // namespace internal
+
+
+/**
+ * \brief Computes the factorization of a matrix on first use and retains it.
+ *
+ *        Whether a factorization is available depends on the matrix and the solver type (see
+ *        internal::Factorization), get() returns nullptr otherwise and the caller has to fall back to the iterative or
+ *        non-retaining solvers of dune-stuff. Thread safe.
+ */
+template< class MatrixType, class VectorType >
+class LazyFactorization
+{
+public:
+  typedef internal::FactorizationInterface< VectorType > FactorizationType;
+
+  explicit LazyFactorization(const std::string type)
+    : type_(type)
+    , computed_(false)
+  {}
+
+  LazyFactorization(const LazyFactorization& other) = delete;
+
+  LazyFactorization& operator=(const LazyFactorization& other) = delete;
+
+  const FactorizationType* get(const MatrixType& matrix) const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (!computed_) {
+      factorization_ = internal::Factorization< MatrixType, VectorType >::create(matrix, type_);
+      computed_ = true;
+    }
+    return factorization_.get();
+  } // ... get(...)
+
+private:
+  const std::string type_;
+  mutable std::mutex mutex_;
+  mutable bool computed_;
+  mutable std::unique_ptr< const FactorizationType > factorization_;
+}; // class LazyFactorization
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_FACTORIZATION_HH
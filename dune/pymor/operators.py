@@ -11,10 +11,11 @@ from pybindgen import retval, param
 from itertools import izip
 
 from pymor.vectorarrays.interfaces import VectorSpace
-from pymor.vectorarrays.list import ListVectorArray
 from pymor.operators.basic import OperatorBase
 from pymor.operators.constructions import LincombOperator
 
+from dune.pymor.la.container import multi_vector_type
+
 
 def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONFIG_H,
                                             operator_name,
@@ -118,79 +119,119 @@ def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONF
     Operator.add_method('apply', None,
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param(operator_RangeType + ' &', 'range')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply', None,
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param(operator_RangeType + ' &', 'range'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_and_return_ptr',
                         retval(operator_RangeType + ' *', caller_owns_return=True),
                         [param('const ' + operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions, custom_name='apply')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Operator.add_method('apply_and_return_ptr',
                         retval(operator_RangeType + ' *', caller_owns_return=True),
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='apply')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Operator.add_method('apply2', operator_ScalarType,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const ' + operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply2', operator_ScalarType,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const ' + operator_SourceType + ' &', 'source'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('invert_options',
                         retval('std::vector< std::string >'),
                         [], is_const=True, is_static=True, throw=exceptions)
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
-                        [], is_const=True, throw=exceptions, custom_name='invert')
+                        [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
                         [param('const std::string', 'option')],
-                        is_const=True, throw=exceptions, custom_name='invert')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
                         [param('const std::string', 'option'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='invert')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source'),
                          param('const std::string', 'option')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source'),
                          param('const std::string', 'option'),
                          param('const Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const std::string', 'option')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const std::string', 'option'),
                          param('const Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
+    Operator.add_method('apply',
+                        retval('std::vector< ' + operator_RangeType + ' >'),
+                        [param('const std::vector< ' + operator_SourceType + ' > &', 'sources')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_many')
+    Operator.add_method('apply',
+                        retval('std::vector< ' + operator_RangeType + ' >'),
+                        [param('const std::vector< ' + operator_SourceType + ' > &', 'sources'),
+                         param('Dune::Pymor::Parameter', 'mu')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_many')
+    Operator.add_method('apply_inverse',
+                        retval('std::vector< ' + operator_SourceType + ' >'),
+                        [param('const std::vector< ' + operator_RangeType + ' > &', 'ranges'),
+                         param('const std::string', 'option')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_many')
+    Operator.add_method('apply_inverse',
+                        retval('std::vector< ' + operator_SourceType + ' >'),
+                        [param('const std::vector< ' + operator_RangeType + ' > &', 'ranges'),
+                         param('const std::string', 'option'),
+                         param('const Dune::Pymor::Parameter', 'mu')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_many')
+    Operator.add_method('apply',
+                        retval(multi_vector_type(operator_ScalarType)),
+                        [param('const ' + multi_vector_type(operator_ScalarType) + ' &', 'sources')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Operator.add_method('apply',
+                        retval(multi_vector_type(operator_ScalarType)),
+                        [param('const ' + multi_vector_type(operator_ScalarType) + ' &', 'sources'),
+                         param('Dune::Pymor::Parameter', 'mu')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Operator.add_method('apply_inverse',
+                        retval(multi_vector_type(operator_ScalarType)),
+                        [param('const ' + multi_vector_type(operator_ScalarType) + ' &', 'ranges'),
+                         param('const std::string', 'option')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
+    Operator.add_method('apply_inverse',
+                        retval(multi_vector_type(operator_ScalarType)),
+                        [param('const ' + multi_vector_type(operator_ScalarType) + ' &', 'ranges'),
+                         param('const std::string', 'option'),
+                         param('const Dune::Pymor::Parameter', 'mu')],
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
     Operator.add_method('freeze_parameter_and_return_ptr',
                         retval(operator_FrozenType + ' *', caller_owns_return=True),
                         [param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
     if container_based:
         Operator.add_method('pb_container',
                             retval(operator_ContainerType + '*', caller_owns_return=True),
@@ -213,79 +254,99 @@ def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONF
     Inverse.add_method('apply', None,
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param(inverse_RangeType + ' &', 'range')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply', None,
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param(inverse_RangeType + ' &', 'range'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_and_return_ptr',
                        retval(inverse_RangeType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions, custom_name='apply')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Inverse.add_method('apply_and_return_ptr',
                        retval(inverse_RangeType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='apply')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Inverse.add_method('apply2', inverse_ScalarType,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const ' + inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply2', inverse_ScalarType,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const ' + inverse_SourceType + ' &', 'source'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('invert_options',
                        retval('std::vector< std::string >'),
                        [], is_const=True, throw=exceptions)
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
-                       [], is_const=True, throw=exceptions, custom_name='invert')
+                       [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
                        [param('const std::string', 'option')],
-                       is_const=True, throw=exceptions, custom_name='invert')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
                        [param('const std::string', 'option'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='invert')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source'),
                         param('const std::string', 'option')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source'),
                         param('const std::string', 'option'),
                         param('const Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const std::string', 'option')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const std::string', 'option'),
                         param('const Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
+    Inverse.add_method('apply',
+                       retval(multi_vector_type(inverse_ScalarType)),
+                       [param('const ' + multi_vector_type(inverse_ScalarType) + ' &', 'sources')],
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Inverse.add_method('apply',
+                       retval(multi_vector_type(inverse_ScalarType)),
+                       [param('const ' + multi_vector_type(inverse_ScalarType) + ' &', 'sources'),
+                        param('Dune::Pymor::Parameter', 'mu')],
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Inverse.add_method('apply_inverse',
+                       retval(multi_vector_type(inverse_ScalarType)),
+                       [param('const ' + multi_vector_type(inverse_ScalarType) + ' &', 'ranges'),
+                        param('const std::string', 'option')],
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
+    Inverse.add_method('apply_inverse',
+                       retval(multi_vector_type(inverse_ScalarType)),
+                       [param('const ' + multi_vector_type(inverse_ScalarType) + ' &', 'ranges'),
+                        param('const std::string', 'option'),
+                        param('const Dune::Pymor::Parameter', 'mu')],
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
     Inverse.add_method('freeze_parameter_and_return_ptr',
                        retval(inverse_FrozenType + ' *', caller_owns_return=True),
                        [param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
     return Operator, Inverse
 
 
@@ -295,14 +356,15 @@ class WrappedOperatorBase(OperatorBase):
 
     vec_type_source = None
     vec_type_range = None
+    array_type = None
 
     _wrapper = None
 
     def __init__(self, op):
         assert isinstance(op, self.wrapped_type)
         self._impl = op
-        self.source = VectorSpace(ListVectorArray, (self.vec_type_source, int(op.dim_source())))
-        self.range = VectorSpace(ListVectorArray, (self.vec_type_range, int(op.dim_range())))
+        self.source = VectorSpace(self.array_type, (self.vec_type_source, int(op.dim_source())))
+        self.range = VectorSpace(self.array_type, (self.vec_type_range, int(op.dim_range())))
         self.linear = op.linear()
         if hasattr(op, 'parametric') and op.parametric():
             pt = self._wrapper[op.parameter_type()]
@@ -314,16 +376,13 @@ class WrappedOperatorBase(OperatorBase):
 
     def apply(self, U, ind=None, mu=None):
         assert U in self.source
-        if ind is not None and not isinstance(ind, list):
-            ind = [ind]
-        vectors = U._list if ind is None else [U._list[i] for i in ind]
+        sources = U._selection(ind)
         if self.parametric:
             mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
-            return ListVectorArray([self.vec_type_range(self._impl.apply(v._impl, mu)) for v in vectors],
-                                   subtype=self.range.subtype)
+            results = self._impl.apply_multi(sources, mu)
         else:
-            return ListVectorArray([self.vec_type_range(self._impl.apply(v._impl)) for v in vectors],
-                                   subtype=self.range.subtype)
+            results = self._impl.apply_multi(sources)
+        return self.array_type(results, self.vec_type_range)
 
     def apply_inverse(self, U, ind=None, mu=None, options=None):
         assert U in self.range
@@ -334,16 +393,13 @@ class WrappedOperatorBase(OperatorBase):
             options = options['type']
         elif options is None:
             options = next(self.invert_options.iterkeys())
-        vectors = U._list if ind is None else [U._list[i] for i in ind]
+        ranges = U._selection(ind)
         if self.parametric:
             mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
-            return ListVectorArray([self.vec_type_source(self._impl.apply_inverse(v._impl, options, mu))
-                                    for v in vectors],
-                                   subtype=self.source.subtype)
+            results = self._impl.apply_inverse_multi(ranges, options, mu)
         else:
-            return ListVectorArray([self.vec_type_source(self._impl.apply_inverse(v._impl, options))
-                                    for v in vectors],
-                                   subtype=self.source.subtype)
+            results = self._impl.apply_inverse_multi(ranges, options)
+        return self.array_type(results, self.vec_type_source)
 
 
 def wrap_operator(cls, wrapper):
@@ -352,6 +408,7 @@ def wrap_operator(cls, wrapper):
         wrapped_type = cls
         vec_type_source = wrapper[cls.type_source()]
         vec_type_range = wrapper[cls.type_range()]
+        array_type = wrapper.multi_vector_class
         _wrapper = wrapper
 
         def __init__(self, op):
@@ -440,6 +497,10 @@ def inject_LinearAffinelyDecomposedContainerBasedImplementation(module,
                      is_const=True,
                      throw=exceptions,
                      custom_name='affine_part')
+    Class.add_method('set_matrix_free', None, [param('const bool', 'matrix_free')], throw=exceptions)
+    Class.add_method('matrix_free', retval('bool'), [], is_const=True, throw=exceptions)
+    Class.add_method('set_inverse_cache_size', None, [param('const size_t', 'size')], throw=exceptions)
+    Class.add_method('inverse_cache_size', retval('size_t'), [], is_const=True, throw=exceptions)
     Class.add_method('linear', retval('bool'), [], is_const=True, throw=exceptions)
     Class.add_method('dim_source',
                      retval(CONFIG_H['DUNE_STUFF_SSIZE_T']),
@@ -450,79 +511,119 @@ def inject_LinearAffinelyDecomposedContainerBasedImplementation(module,
     Class.add_method('apply', None,
                      [param('const ' + SourceType + ' &', 'source'),
                       param(RangeType + ' &', 'range')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply', None,
                      [param('const ' + SourceType + ' &', 'source'),
                       param(RangeType + ' &', 'range'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_and_return_ptr',
                      retval(RangeType + ' *', caller_owns_return=True),
                      [param('const ' + SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions, custom_name='apply')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Class.add_method('apply_and_return_ptr',
                      retval(RangeType + ' *', caller_owns_return=True),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='apply')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Class.add_method('apply2', ScalarType,
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const ' + SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply2', ScalarType,
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const ' + SourceType + ' &', 'source'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('invert_options',
                      retval('std::vector< std::string >'),
                      [], is_const=True, throw=exceptions)
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
-                     [], is_const=True, throw=exceptions, custom_name='invert')
+                     [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
                      [param('const std::string', 'option')],
-                     is_const=True, throw=exceptions, custom_name='invert')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
                      [param('const std::string', 'option'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='invert')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source'),
                       param('const std::string', 'option')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source'),
                       param('const std::string', 'option'),
                       param('const Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const std::string', 'option')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const std::string', 'option'),
                       param('const Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
+    Class.add_method('apply',
+                     retval('std::vector< ' + RangeType + ' >'),
+                     [param('const std::vector< ' + SourceType + ' > &', 'sources')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_many')
+    Class.add_method('apply',
+                     retval('std::vector< ' + RangeType + ' >'),
+                     [param('const std::vector< ' + SourceType + ' > &', 'sources'),
+                      param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_many')
+    Class.add_method('apply_inverse',
+                     retval('std::vector< ' + SourceType + ' >'),
+                     [param('const std::vector< ' + RangeType + ' > &', 'ranges'),
+                      param('const std::string', 'option')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_many')
+    Class.add_method('apply_inverse',
+                     retval('std::vector< ' + SourceType + ' >'),
+                     [param('const std::vector< ' + RangeType + ' > &', 'ranges'),
+                      param('const std::string', 'option'),
+                      param('const Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_many')
+    Class.add_method('apply',
+                     retval(multi_vector_type(ScalarType)),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Class.add_method('apply',
+                     retval(multi_vector_type(ScalarType)),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'sources'),
+                      param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_multi')
+    Class.add_method('apply_inverse',
+                     retval(multi_vector_type(ScalarType)),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'ranges'),
+                      param('const std::string', 'option')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
+    Class.add_method('apply_inverse',
+                     retval(multi_vector_type(ScalarType)),
+                     [param('const ' + multi_vector_type(ScalarType) + ' &', 'ranges'),
+                      param('const std::string', 'option'),
+                      param('const Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse_multi')
     Class.add_method('freeze_parameter_and_return_ptr',
                      retval(FrozenType + ' *', caller_owns_return=True),
                      [param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
     return Class
 
 
@@ -541,6 +642,21 @@ def wrap_affinely_decomposed_operator(cls, wrapper):
                 coefficients.append(1.)
             LincombOperator.__init__(self, operators, coefficients)
 
+        def apply(self, U, ind=None, mu=None):
+            # apply all components in C++ at once instead of combining the results of the components in python
+            if not (self.operators and all(isinstance(op, WrappedOperatorBase) for op in self.operators)
+                    and isinstance(U, self.operators[0].array_type)):
+                return LincombOperator.apply(self, U, ind=ind, mu=mu)
+            op = self.operators[0]
+            assert U in self.source
+            sources = U._selection(ind)
+            if self.parametric:
+                mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
+                results = self._impl.apply_multi(sources, mu)
+            else:
+                results = self._impl.apply_multi(sources)
+            return op.array_type(results, op.vec_type_range)
+
         def with_(self, **kwargs):
             assert 'operators' in kwargs
             ops = kwargs['operators']
@@ -6,12 +6,18 @@
 #ifndef DUNE_PYMOR_OPERATORS_AFFINE_HH
 #define DUNE_PYMOR_OPERATORS_AFFINE_HH
 
+#include <string>
+#include <memory>
+#include <sstream>
+#include <utility>
 #include <type_traits>
+#include <vector>
 
 #include <dune/stuff/common/profiler.hh>
 #include <dune/stuff/la/container.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/cache.hh>
 #include <dune/pymor/la/container/affine.hh>
 
 #include "base.hh"
@@ -54,16 +60,34 @@ public:
   typedef typename Traits::ScalarType     ScalarType;
   typedef typename Traits::FrozenType     FrozenType;
   typedef typename Traits::InverseType    InverseType;
+  typedef typename BaseType::MultiVectorType MultiVectorType;
 
 private:
   typedef LA::AffinelyDecomposedConstContainer< MatrixImp > AffinelyDecomposedContainerType;
+  typedef std::pair< FlatParameter, std::string > InverseCacheKeyType;
+
+  struct InverseCacheKeyHash
+  {
+    size_t operator()(const InverseCacheKeyType& key) const
+    {
+      return std::hash< FlatParameter >()(key.first) ^ (std::hash< std::string >()(key.second) << 1);
+    }
+  };
+
+  typedef LRUCache< InverseCacheKeyType, InverseType, InverseCacheKeyHash > InverseCacheType;
 
 public:
   static std::string static_id() { return "pymor.operators.linearaffinelydecomposedcontainerbased"; }
 
-  LinearAffinelyDecomposedContainerBased(const AffinelyDecomposedContainerType affinelyDecomposedContainer)
+  /**
+   * \param matrix_free see set_matrix_free()
+   */
+  LinearAffinelyDecomposedContainerBased(const AffinelyDecomposedContainerType affinelyDecomposedContainer,
+                                         const bool matrix_free = false)
     : BaseType(affinelyDecomposedContainer)
     , affinelyDecomposedContainer_(affinelyDecomposedContainer)
+    , matrix_free_(matrix_free)
+    , inverse_cache_(std::make_shared< InverseCacheType >(0))
   {
     if (!affinelyDecomposedContainer_.has_affine_part() && affinelyDecomposedContainer_.num_components() == 0)
       DUNE_THROW(Stuff::Exceptions::requirements_not_met, "affinelyDecomposedContainer must not be empty!");
@@ -76,6 +100,23 @@ public:
     }
   }
 
+  /**
+   * \brief Selects how apply() treats a parametric operator.
+   *
+   *        By default the matrix for mu is assembled and applied. If matrix_free is true, each component is applied
+   *        separately and the results are accumulated, range = A_aff * source + sum_q theta_q(mu) * A_q * source, which
+   *        is cheaper whenever the assembled matrix would only be used once.
+   */
+  void set_matrix_free(const bool matrix_free)
+  {
+    matrix_free_ = matrix_free;
+  }
+
+  bool matrix_free() const
+  {
+    return matrix_free_;
+  }
+
   DUNE_STUFF_SSIZE_T num_components() const
   {
     return affinelyDecomposedContainer_.num_components();
@@ -124,10 +165,29 @@ public:
                  << ") does not match the parameter_type of this (" << Parametric::parameter_type() << ")!");
     if (!Parametric::parametric())
       ComponentType(affinelyDecomposedContainer_.affine_part()).apply(source, range);
+    else if (matrix_free_)
+      apply_matrix_free(source, range, mu);
     else
       freeze_parameter(mu).apply(source, range);
   }
 
+  /**
+   * \brief Applies this to all vectors of sources at once, the matrix (or each component) is traversed only once.
+   */
+  void apply(const MultiVectorType& sources, MultiVectorType& ranges, const Parameter mu = Parameter()) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    if (mu.type() != Parametric::parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type, "the type of mu (" << mu.type()
+                 << ") does not match the parameter_type of this (" << Parametric::parameter_type() << ")!");
+    if (!Parametric::parametric())
+      ComponentType(affinelyDecomposedContainer_.affine_part()).apply(sources, ranges);
+    else if (matrix_free_)
+      apply_matrix_free(sources, ranges, mu);
+    else
+      freeze_parameter(mu).apply(sources, ranges);
+  } // ... apply(...)
+
   using BaseType::apply;
 
   static std::vector< std::string > invert_options()
@@ -140,9 +200,38 @@ public:
     return ComponentType::invert_options(type);
   }
 
+  /**
+   * \brief Returns the inverse for mu, which is taken from a cache of the most recently used inverses, if enabled.
+   *
+   *        Since the inverse retains the factorization of the frozen matrix (for direct solvers), any subsequent
+   *        inversion for the same mu and option neither assembles nor factorizes again. The cache is disabled by
+   *        default, see set_inverse_cache_size().
+   */
   InverseType invert(const Stuff::Common::Configuration& option, const Parameter mu = Parameter()) const
   {
-    return freeze_parameter(mu).invert(option);
+    if (inverse_cache_->capacity() == 0)
+      return freeze_parameter(mu).invert(option);
+    std::ostringstream option_string;
+    option.report(option_string);
+    return *inverse_cache_->get_or_create(InverseCacheKeyType(FlatParameter(mu), option_string.str()),
+                                          [&]() { return freeze_parameter(mu).invert(option); });
+  } // ... invert(...)
+
+  /**
+   * \brief Sets the number of inverses retained by invert(), 0 (the default) disables the cache.
+   *
+   *        Each cached inverse holds an assembled matrix and, for direct solvers, its factorization, the fill-in of
+   *        which may exceed the memory of the matrix by far for sparse matrices. Only enable the cache (usually with
+   *        a size of 1) if the same parameter is inverted repeatedly, e.g. for several right hand sides.
+   */
+  void set_inverse_cache_size(const size_t size)
+  {
+    inverse_cache_->set_capacity(size);
+  }
+
+  size_t inverse_cache_size() const
+  {
+    return inverse_cache_->capacity();
   }
 
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
@@ -155,10 +244,92 @@ public:
     return FrozenType(new MatrixImp(affinelyDecomposedContainer_.freeze_parameter(mu)));
   }
 
+  /**
+   * \brief Assembles the matrix for mu into target, which is reused for all parameters of the same structure.
+   */
+  void freeze_parameter_into(const Parameter mu, MatrixImp& target) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".freeze_parameter_into");
+    if (mu.type() != Parametric::parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                 << Parametric::parameter_type() << ")!");
+    affinelyDecomposedContainer_.freeze_parameter_into(mu, target);
+  }
+
 private:
+  void apply_matrix_free(const SourceType& source, RangeType& range, const Parameter& mu) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply_matrix_free");
+    if (source.pb_dim() != dim_source_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of source (" << source.pb_dim() << ") does not match the dim_source of this ("
+                 << dim_source_ << ")!");
+    if (range.pb_dim() != dim_range_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of range (" << range.pb_dim() << ") does not match the dim_range of this ("
+                 << dim_range_ << ")!");
+    // reused by all calls on this thread, such that the matrix free application does not allocate
+    static thread_local std::vector< double > thetas;
+    static thread_local RangeType tmp;
+    affinelyDecomposedContainer_.evaluate_coefficients(FlatParameter(mu), thetas);
+    const size_t num_components = thetas.size();
+    size_t qq = 0;
+    if (affinelyDecomposedContainer_.has_affine_part())
+      affinelyDecomposedContainer_.affine_part()->mv(source, range);
+    else {
+      affinelyDecomposedContainer_.component(0)->mv(source, range);
+      range.scal(thetas[0]);
+      qq = 1;
+    }
+    if (qq == num_components)
+      return;
+    // all remaining components share one temporary
+    if (tmp.size() != range.size())
+      tmp = RangeType(range.size());
+    for (; qq < num_components; ++qq) {
+      affinelyDecomposedContainer_.component(qq)->mv(source, tmp);
+      range.axpy(thetas[qq], tmp);
+    }
+  } // ... apply_matrix_free(...)
+
+  void apply_matrix_free(const MultiVectorType& sources, MultiVectorType& ranges, const Parameter& mu) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply_matrix_free");
+    BaseType::check_multi_vectors(sources, dim_source_, ranges, dim_range_);
+    if (sources.len() == 0)
+      return;
+    typedef LA::internal::BlockMv< MatrixImp, VectorImp > BlockMvType;
+    // reused by all calls on this thread, such that the matrix free application does not allocate
+    static thread_local std::vector< double > thetas;
+    static thread_local MultiVectorType tmp;
+    affinelyDecomposedContainer_.evaluate_coefficients(FlatParameter(mu), thetas);
+    const size_t num_components = thetas.size();
+    size_t qq = 0;
+    if (affinelyDecomposedContainer_.has_affine_part())
+      BlockMvType::apply(*affinelyDecomposedContainer_.affine_part(), sources, ranges);
+    else {
+      BlockMvType::apply(*affinelyDecomposedContainer_.component(0), sources, ranges);
+      ranges.scal(thetas[0]);
+      qq = 1;
+    }
+    if (qq == num_components)
+      return;
+    // all remaining components share one temporary
+    if (tmp.dim() != ranges.dim() || tmp.len() != ranges.len())
+      tmp = MultiVectorType(ranges.dim(), ranges.len());
+    for (; qq < num_components; ++qq) {
+      BlockMvType::apply(*affinelyDecomposedContainer_.component(qq), sources, tmp);
+      ranges.axpy(thetas[qq], tmp);
+    }
+  } // ... apply_matrix_free(...)
+
   AffinelyDecomposedContainerType affinelyDecomposedContainer_;
   DUNE_STUFF_SSIZE_T dim_source_;
   DUNE_STUFF_SSIZE_T dim_range_;
+  bool matrix_free_;
+  //! shared by all copies of this operator, which share the same components
+  std::shared_ptr< InverseCacheType > inverse_cache_;
 }; // class LinearAffinelyDecomposedContainerBased
 
 
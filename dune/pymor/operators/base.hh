@@ -6,6 +6,9 @@
 #ifndef DUNE_PYMOR_OPERATORS_BASE_HH
 #define DUNE_PYMOR_OPERATORS_BASE_HH
 
+#include <cmath>
+#include <memory>
+#include <string>
 #include <type_traits>
 
 #include <dune/stuff/common/exceptions.hh>
@@ -14,6 +17,8 @@
 #include <dune/stuff/la/container/interfaces.hh>
 #include <dune/stuff/la/solver.hh>
 
+#include <dune/pymor/la/factorization.hh>
+
 #include "interfaces.hh"
 
 namespace Dune {
@@ -94,23 +99,35 @@ public:
   MatrixBasedInverseDefault(const MatrixType* matrix_ptr, const std::string type = LinearSolverType::options()[0])
     : matrix_(matrix_ptr)
     , options_(LinearSolverType::options(type))
+    , factorization_(create_factorization(options_))
+    , check_for_inf_nan_(solver_option< int >(options_, "check_for_inf_nan") != 0)
+    , post_check_solves_system_(solver_option< ScalarType >(options_, "post_check_solves_system"))
   {}
 
   MatrixBasedInverseDefault(const MatrixType* matrix_ptr, const Stuff::Common::Configuration& options)
     : matrix_(matrix_ptr)
     , options_(options)
+    , factorization_(create_factorization(options_))
+    , check_for_inf_nan_(solver_option< int >(options_, "check_for_inf_nan") != 0)
+    , post_check_solves_system_(solver_option< ScalarType >(options_, "post_check_solves_system"))
   {}
 
   MatrixBasedInverseDefault(const std::shared_ptr< const MatrixType > matrix_ptr,
                             const std::string type = LinearSolverType::options()[0])
     : matrix_(matrix_ptr)
     , options_(LinearSolverType::options(type))
+    , factorization_(create_factorization(options_))
+    , check_for_inf_nan_(solver_option< int >(options_, "check_for_inf_nan") != 0)
+    , post_check_solves_system_(solver_option< ScalarType >(options_, "post_check_solves_system"))
   {}
 
   MatrixBasedInverseDefault(const std::shared_ptr< const MatrixType > matrix_ptr,
                             const Stuff::Common::Configuration& options)
     : matrix_(matrix_ptr)
     , options_(options)
+    , factorization_(create_factorization(options_))
+    , check_for_inf_nan_(solver_option< int >(options_, "check_for_inf_nan") != 0)
+    , post_check_solves_system_(solver_option< ScalarType >(options_, "post_check_solves_system"))
   {}
 
   bool linear() const
@@ -141,7 +158,12 @@ public:
       DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
                  "the dim of range (" << range.pb_dim() << ") does not match the dim_range of this ("
                  << dim_range() << ")!");
-    LinearSolverType(*matrix_).apply(source, range, options_);
+    const auto factorization = factorization_->get(*matrix_);
+    if (factorization) {
+      factorization->solve(source, range);
+      check_solution(source, range);
+    } else
+      LinearSolverType(*matrix_).apply(source, range, options_);
   } // ... apply(...)
 
   using BaseType::apply;
@@ -181,8 +203,56 @@ public:
   } // ... freeze_parameter(...)
 
 private:
+  typedef LA::LazyFactorization< MatrixType, VectorType > FactorizationType;
+
+  static std::shared_ptr< const FactorizationType > create_factorization(const Stuff::Common::Configuration& options)
+  {
+    return std::make_shared< const FactorizationType >(options.has_key("type") ? options.get< std::string >("type")
+                                                                                : std::string());
+  }
+
+  /**
+   * \brief Returns options[key], or the default of the solver type given in options, or 0.
+   */
+  template< class T >
+  static T solver_option(const Stuff::Common::Configuration& options, const std::string& key)
+  {
+    if (options.has_key(key))
+      return options.get< T >(key);
+    if (options.has_key("type")) {
+      const Stuff::Common::Configuration defaults = LinearSolverType::options(options.get< std::string >("type"));
+      if (defaults.has_key(key))
+        return defaults.get< T >(key);
+    }
+    return T(0);
+  } // ... solver_option(...)
+
+  /**
+   * \brief Performs the checks of Stuff::LA::Solver requested by the options, which the retained factorization skips.
+   */
+  void check_solution(const SourceType& source, const RangeType& range) const
+  {
+    if (check_for_inf_nan_ && !range.valid())
+      DUNE_THROW(Stuff::Exceptions::linear_solver_failed,
+                 "the solution contains inf or nan (see option 'check_for_inf_nan')!");
+    if (post_check_solves_system_ > 0) {
+      auto residual = source.copy();
+      matrix_->mv(range, residual);
+      residual.axpy(-1., source);
+      const ScalarType sup_norm = residual.sup_norm();
+      if (sup_norm > post_check_solves_system_ || std::isnan(sup_norm) || std::isinf(sup_norm))
+        DUNE_THROW(Stuff::Exceptions::linear_solver_failed,
+                   "the solution does not solve the system (sup norm of the residual: " << sup_norm
+                   << ", see option 'post_check_solves_system')!");
+    }
+  } // ... check_solution(...)
+
   std::shared_ptr< const MatrixType > matrix_;
   const Stuff::Common::Configuration options_;
+  //! computed on the first call to apply() and shared by all copies of this inverse
+  std::shared_ptr< const FactorizationType > factorization_;
+  const bool check_for_inf_nan_;
+  const ScalarType post_check_solves_system_;
 }; // class MatrixBasedInverseDefault
 
 
@@ -201,6 +271,7 @@ public:
   typedef typename Traits::ContainerType  ContainerType;
   typedef typename Traits::FrozenType     FrozenType;
   typedef typename Traits::InverseType    InverseType;
+  typedef typename BaseType::MultiVectorType MultiVectorType;
 
 protected:
   typedef MatrixImp MatrixType;
@@ -258,6 +329,19 @@ public:
     matrix_->mv(source, range);
   } // ... apply(...)
 
+  /**
+   * \brief Applies the matrix to all vectors of sources at once, i.e., computes one matrix-matrix product.
+   */
+  void apply(const MultiVectorType& sources, MultiVectorType& ranges, const Parameter mu = Parameter()) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    if (!mu.empty()) DUNE_THROW(Exceptions::this_is_not_parametric,
+                                "mu has to be empty if parametric() == false (is " << mu << ")!");
+    BaseType::check_multi_vectors(sources, dim_source(), ranges, dim_range());
+    if (sources.len() > 0)
+      LA::internal::BlockMv< MatrixType, VectorType >::apply(*matrix_, sources, ranges);
+  } // ... apply(...)
+
   using BaseType::apply;
 
   static std::vector< std::string > invert_options()
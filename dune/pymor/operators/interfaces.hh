@@ -6,6 +6,9 @@
 #ifndef DUNE_PYMOR_OPERATORS_INTERFACES_HH
 #define DUNE_PYMOR_OPERATORS_INTERFACES_HH
 
+#include <string>
+#include <vector>
+
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/crtp.hh>
 #include <dune/stuff/common/profiler.hh>
@@ -15,6 +18,7 @@
 #include <dune/stuff/la/solver.hh>
 
 #include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/la/container/multivector.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
 
@@ -48,6 +52,7 @@ public:
   typedef typename Traits::ScalarType   ScalarType;
   typedef typename Traits::FrozenType   FrozenType;
   typedef typename Traits::InverseType  InverseType;
+  typedef LA::MultiVector< ScalarType > MultiVectorType;
 
   static_assert(std::is_base_of< Stuff::LA::VectorInterface< typename SourceType::Traits >, SourceType >::value,
                 "SourceType has to be derived from Stuff::LA::VectorInterface!");
@@ -106,6 +111,70 @@ public:
     return new RangeType(apply(source, mu));
   }
 
+  /**
+   * \brief Applies the operator to each of sources, a parametric operator is frozen only once.
+   */
+  void apply(const std::vector< SourceType >& sources,
+             std::vector< RangeType >& ranges,
+             const Parameter mu = Parameter()) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    if (ranges.size() != sources.size())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of ranges (" << ranges.size() << ") does not match the size of sources ("
+                 << sources.size() << ")!");
+    if (sources.empty())
+      return;
+    if (this->parametric()) {
+      const auto frozen = freeze_parameter(mu);
+      for (size_t ii = 0; ii < sources.size(); ++ii)
+        frozen.apply(sources[ii], ranges[ii]);
+    } else
+      for (size_t ii = 0; ii < sources.size(); ++ii)
+        apply(sources[ii], ranges[ii], mu);
+  } // ... apply(...)
+
+  std::vector< RangeType > apply(const std::vector< SourceType >& sources, const Parameter mu = Parameter()) const
+  {
+    std::vector< RangeType > ranges(sources.size());
+    for (auto& range : ranges)
+      range = RangeType(dim_range());
+    apply(sources, ranges, mu);
+    return ranges;
+  }
+
+  /**
+   * \brief Applies the operator to each vector of sources, a parametric operator is frozen only once.
+   *
+   *        The frozen operator is applied to all vectors at once, derived classes which can do better than one
+   *        apply() per vector (e.g., by a matrix-matrix product) should implement this method.
+   */
+  void apply(const MultiVectorType& sources, MultiVectorType& ranges, const Parameter mu = Parameter()) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    check_multi_vectors(sources, dim_source(), ranges, dim_range());
+    if (sources.len() == 0)
+      return;
+    if (this->parametric()) {
+      freeze_parameter(mu).apply(sources, ranges);
+      return;
+    }
+    SourceType source(dim_source());
+    RangeType range(dim_range());
+    for (size_t ii = 0; ii < sources.len(); ++ii) {
+      sources.get(ii, source);
+      apply(source, range, mu);
+      ranges.set(ii, range);
+    }
+  } // ... apply(...)
+
+  MultiVectorType apply(const MultiVectorType& sources, const Parameter mu = Parameter()) const
+  {
+    MultiVectorType ranges(dim_range(), sources.len());
+    this->as_imp(*this).apply(sources, ranges, mu);
+    return ranges;
+  }
+
   /**
    * \note  This default implementation of apply2 creates a temporary vector. Any derived class which can do better
    *        should implement this method!
@@ -189,6 +258,90 @@ public:
     return source;
   }
 
+  /**
+   * \brief Solves for each of ranges, the operator is frozen and inverted (and thus factorized) only once.
+   */
+  void apply_inverse(const std::vector< RangeType >& ranges,
+                     std::vector< SourceType >& sources,
+                     const Stuff::Common::Configuration& option,
+                     const Parameter mu = Parameter()) const
+  {
+    if (sources.size() != ranges.size())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of sources (" << sources.size() << ") does not match the size of ranges ("
+                 << ranges.size() << ")!");
+    if (ranges.empty())
+      return;
+    const auto inverse = invert(option, mu);
+    for (size_t ii = 0; ii < ranges.size(); ++ii)
+      inverse.apply(ranges[ii], sources[ii]);
+  } // ... apply_inverse(...)
+
+  void apply_inverse(const std::vector< RangeType >& ranges,
+                     std::vector< SourceType >& sources,
+                     const std::string type = invert_options()[0],
+                     const Parameter mu = Parameter()) const
+  {
+    auto logger = DSC::TimedLogger().get("dune.pymor.operators.interfaces.apply_inverse");
+    logger.info() << "inverting ";
+    if (!mu.empty())
+      logger.info() << "for mu=" << mu << " ";
+    logger.info() << "with type " << type << " for " << ranges.size() << " right hand sides" << std::endl;
+    apply_inverse(ranges, sources, invert_options(type), mu);
+  }
+
+  std::vector< SourceType > apply_inverse(const std::vector< RangeType >& ranges,
+                                          const std::string type = invert_options()[0],
+                                          const Parameter mu = Parameter()) const
+  {
+    std::vector< SourceType > sources(ranges.size());
+    for (auto& source : sources)
+      source = SourceType(dim_source());
+    apply_inverse(ranges, sources, type, mu);
+    return sources;
+  }
+
+  std::vector< SourceType > apply_inverse(const std::vector< RangeType >& ranges,
+                                          const Stuff::Common::Configuration& option,
+                                          const Parameter mu = Parameter()) const
+  {
+    std::vector< SourceType > sources(ranges.size());
+    for (auto& source : sources)
+      source = SourceType(dim_source());
+    apply_inverse(ranges, sources, option, mu);
+    return sources;
+  }
+
+  /**
+   * \brief Solves for each vector of ranges, the operator is frozen and inverted (and thus factorized) only once.
+   */
+  void apply_inverse(const MultiVectorType& ranges,
+                     MultiVectorType& sources,
+                     const Stuff::Common::Configuration& option,
+                     const Parameter mu = Parameter()) const
+  {
+    check_multi_vectors(sources, dim_source(), ranges, dim_range());
+    if (ranges.len() == 0)
+      return;
+    const auto inverse = invert(option, mu);
+    RangeType range(dim_range());
+    SourceType source(dim_source());
+    for (size_t ii = 0; ii < ranges.len(); ++ii) {
+      ranges.get(ii, range);
+      inverse.apply(range, source);
+      sources.set(ii, source);
+    }
+  } // ... apply_inverse(...)
+
+  MultiVectorType apply_inverse(const MultiVectorType& ranges,
+                                const std::string type = invert_options()[0],
+                                const Parameter mu = Parameter()) const
+  {
+    MultiVectorType sources(dim_source(), ranges.len());
+    apply_inverse(ranges, sources, invert_options(type), mu);
+    return sources;
+  }
+
   SourceType* apply_inverse_and_return_ptr(const RangeType& range,
                                            const std::string type = invert_options()[0],
                                            const Parameter mu = Parameter()) const
@@ -216,6 +369,24 @@ public:
   {
     return new FrozenType(freeze_parameter(mu));
   }
+
+protected:
+  static void check_multi_vectors(const MultiVectorType& sources,
+                                  const DUNE_STUFF_SSIZE_T source_dim,
+                                  const MultiVectorType& ranges,
+                                  const DUNE_STUFF_SSIZE_T range_dim)
+  {
+    if (static_cast< DUNE_STUFF_SSIZE_T >(sources.dim()) != source_dim
+        || static_cast< DUNE_STUFF_SSIZE_T >(ranges.dim()) != range_dim)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of sources (" << sources.dim() << ") and ranges (" << ranges.dim()
+                 << ") does not match the dim_source (" << source_dim << ") and dim_range (" << range_dim
+                 << ") of this!");
+    if (ranges.len() != sources.len())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the len of ranges (" << ranges.len() << ") does not match the len of sources (" << sources.len()
+                 << ")!");
+  } // ... check_multi_vectors(...)
 }; // class OperatorInterface
 
 
@@ -7,3 +7,4 @@ from __future__ import absolute_import
 
 from .base import inject_ParameterType, inject_Parameter, inject_Parametric
 from .functional import inject_ParameterFunctional
+from .sampling import inject_ParameterSampler
@@ -6,6 +6,7 @@
 #include "config.h"
 
 #include <type_traits>
+#include <algorithm>
 
 #include <dune/stuff/common/exceptions.hh>
 
@@ -129,10 +130,102 @@ template class KeyValueBase< std::string, DUNE_STUFF_SSIZE_T >;
 template class KeyValueBase< std::string, std::vector< double > >;
 
 
+namespace internal {
+
+
+static void hash_combine(size_t& seed, const size_t value)
+{
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+
+} // namespace internal
+
+
+// ===========================
+// ===== ParameterLayout =====
+// ===========================
+ParameterLayout::ParameterLayout()
+  : offsets_(1, 0)
+  , hash_(0)
+{}
+
+ParameterLayout::ParameterLayout(const std::vector< std::string >& kk, const std::vector< DUNE_STUFF_SSIZE_T >& vv)
+  : keys_(kk)
+  , offsets_(1, 0)
+  , hash_(0)
+{
+  if (kk.size() != vv.size())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of kk (" << kk.size() << ") has to equal the size of vv (" << vv.size() << ")!");
+  for (size_t ii = 0; ii < kk.size(); ++ii) {
+    offsets_.push_back(offsets_[ii] + vv[ii]);
+    indices_[kk[ii]] = ii;
+    internal::hash_combine(hash_, std::hash< std::string >()(kk[ii]));
+    internal::hash_combine(hash_, vv[ii]);
+  }
+}
+
+const std::vector< std::string >& ParameterLayout::keys() const
+{
+  return keys_;
+}
+
+bool ParameterLayout::hasKey(const std::string& key) const
+{
+  return indices_.find(key) != indices_.end();
+}
+
+size_t ParameterLayout::index(const std::string& key) const
+{
+  const auto result = indices_.find(key);
+  if (result == indices_.end())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "key '" << key << "' is not contained in this layout!");
+  return result->second;
+}
+
+size_t ParameterLayout::offset(const std::string& key) const
+{
+  return offsets_[index(key)];
+}
+
+size_t ParameterLayout::size(const std::string& key) const
+{
+  const size_t ii = index(key);
+  return offsets_[ii + 1] - offsets_[ii];
+}
+
+const std::vector< size_t >& ParameterLayout::offsets() const
+{
+  return offsets_;
+}
+
+size_t ParameterLayout::dim() const
+{
+  return offsets_.back();
+}
+
+size_t ParameterLayout::hash() const
+{
+  return hash_;
+}
+
+bool ParameterLayout::operator==(const ParameterLayout& other) const
+{
+  return this == &other || (hash_ == other.hash_ && offsets_ == other.offsets_ && keys_ == other.keys_);
+}
+
+bool ParameterLayout::operator!=(const ParameterLayout& other) const
+{
+  return !operator==(other);
+}
+
+
 // =========================
 // ===== ParameterType =====
 // =========================
 ParameterType::ParameterType()
+  : layout_(std::make_shared< ParameterLayout >())
 {}
 
 ParameterType::ParameterType(const KeyType& kk, const ValueType& vv)
@@ -140,6 +233,7 @@ ParameterType::ParameterType(const KeyType& kk, const ValueType& vv)
 {
   if (kk.empty()) DUNE_THROW(Stuff::Exceptions::wrong_input_given, "kk is empty!");
   if (vv <= 0) DUNE_THROW(Stuff::Exceptions::index_out_of_range, "vv has to be positive (is " << vv << ")!");
+  update_layout();
 }
 
 ParameterType::ParameterType(const std::vector< KeyType >& kk, const std::vector< ValueType >& vv)
@@ -161,6 +255,7 @@ ParameterType::ParameterType(const std::vector< KeyType >& kk, const std::vector
       DUNE_THROW(Stuff::Exceptions::index_out_of_range,
                  "vv[" << counter << "] has to be positive (is " << value << ")!");
   }
+  update_layout();
 }
 
 void ParameterType::set(const KeyType& key, const ValueType& value)
@@ -170,6 +265,7 @@ void ParameterType::set(const KeyType& key, const ValueType& value)
   if (!hasKey(key)) {
     BaseType::dict_[key] = value;
     BaseType::update();
+    update_layout();
   }
 }
 
@@ -214,6 +310,16 @@ std::string ParameterType::report_for_filename() const
   return ret.str();
 }
 
+const std::shared_ptr< const ParameterLayout >& ParameterType::layout() const
+{
+  return layout_;
+}
+
+void ParameterType::update_layout()
+{
+  layout_ = std::make_shared< ParameterLayout >(keys(), values());
+}
+
 
 std::ostream& operator<<(std::ostream& oo, const ParameterType& pp)
 {
@@ -412,6 +518,28 @@ Parameter::ValueType Parameter::serialize() const
   return ret;
 } // ValueType serialize() const
 
+void Parameter::deserialize(const ValueType& vv)
+{
+  deserialize(vv.data(), vv.size());
+}
+
+void Parameter::deserialize(const double* values, const size_t size)
+{
+  const auto layout = type_.layout();
+  if (size != layout->dim())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the number of values (" << size << ") has to equal the dimension of the type (" << layout->dim()
+               << ")!");
+  const auto& offsets = layout->offsets();
+  size_t ii = 0;
+  // dict_ is ordered by key, as are keys_, values_ and the layout
+  for (auto& element : BaseType::dict_) {
+    element.second.assign(values + offsets[ii], values + offsets[ii + 1]);
+    BaseType::values_[ii] = element.second;
+    ++ii;
+  }
+} // ... deserialize(...)
+
 bool Parameter::operator==(const double& val) const
 {
   if (keys().size() != 1 || values().size() != 1 || values()[0].size() != 1)
@@ -450,29 +578,224 @@ std::ostream& operator<<(std::ostream& oo, const Parameter& pp)
 }
 
 
+// =========================
+// ===== FlatParameter =====
+// =========================
+FlatParameter::FlatParameter()
+  : layout_(ParameterType().layout())
+  , hash_(layout_->hash())
+{}
+
+FlatParameter::FlatParameter(const Parameter& mu)
+  : FlatParameter(mu.type().layout(), mu.serialize())
+{}
+
+FlatParameter::FlatParameter(const ParameterType& tt, const std::vector< double >& vv)
+  : FlatParameter(tt.layout(), std::vector< double >(vv))
+{}
+
+FlatParameter::FlatParameter(const std::shared_ptr< const ParameterLayout >& layout, std::vector< double >&& vv)
+  : layout_(layout)
+  , values_(std::move(vv))
+  , hash_(layout_->hash())
+{
+  if (values_.size() != layout_->dim())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of vv (" << values_.size() << ") has to equal the dimension of the layout ("
+               << layout_->dim() << ")!");
+  for (const auto& value : values_)
+    internal::hash_combine(hash_, std::hash< double >()(value));
+}
+
+const std::shared_ptr< const ParameterLayout >& FlatParameter::layout() const
+{
+  return layout_;
+}
+
+bool FlatParameter::has_type(const ParameterType& tt) const
+{
+  return layout_ == tt.layout() || *layout_ == *tt.layout();
+}
+
+const std::vector< double >& FlatParameter::values() const
+{
+  return values_;
+}
+
+const double* FlatParameter::data() const
+{
+  return values_.data();
+}
+
+size_t FlatParameter::size() const
+{
+  return values_.size();
+}
+
+const double* FlatParameter::get(const std::string& key) const
+{
+  return values_.data() + layout_->offset(key);
+}
+
+size_t FlatParameter::hash() const
+{
+  return hash_;
+}
+
+Parameter FlatParameter::parameter() const
+{
+  Parameter ret;
+  const auto& kk = layout_->keys();
+  const auto& offsets = layout_->offsets();
+  for (size_t ii = 0; ii < kk.size(); ++ii)
+    ret.set(kk[ii], std::vector< double >(values_.begin() + offsets[ii], values_.begin() + offsets[ii + 1]));
+  return ret;
+}
+
+std::string FlatParameter::report() const
+{
+  return parameter().report();
+}
+
+bool FlatParameter::operator==(const FlatParameter& other) const
+{
+  return hash_ == other.hash_ && values_ == other.values_ && *layout_ == *other.layout_;
+}
+
+bool FlatParameter::operator!=(const FlatParameter& other) const
+{
+  return !operator==(other);
+}
+
+bool FlatParameter::operator<(const FlatParameter& other) const
+{
+  if (*layout_ != *other.layout_) {
+    if (layout_->keys() != other.layout_->keys())
+      return layout_->keys() < other.layout_->keys();
+    return layout_->offsets() < other.layout_->offsets();
+  }
+  return values_ < other.values_;
+}
+
+std::ostream& operator<<(std::ostream& oo, const FlatParameter& pp)
+{
+  oo << pp.report();
+  return oo;
+}
+
+
+// ===============================
+// ===== ParameterProjection =====
+// ===============================
+ParameterProjection::ParameterProjection(const ParameterLayout& source,
+                                         const std::shared_ptr< const ParameterLayout >& target)
+  : layout_(target)
+{
+  const auto& kk = layout_->keys();
+  const auto& offsets = layout_->offsets();
+  for (size_t ii = 0; ii < kk.size(); ++ii) {
+    const size_t source_offset = source.offset(kk[ii]);
+    const size_t size = offsets[ii + 1] - offsets[ii];
+    if (size != source.size(kk[ii]))
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size for key '" << kk[ii] << "' in target (" << size << ") does not match the size in source ("
+                 << source.size(kk[ii]) << ")!");
+    if (!blocks_.empty()
+        && blocks_.back().source + blocks_.back().size == source_offset
+        && blocks_.back().target + blocks_.back().size == offsets[ii])
+      blocks_.back().size += size;
+    else
+      blocks_.push_back({source_offset, offsets[ii], size});
+  }
+  identity_ = (layout_->dim() == source.dim())
+              && (blocks_.empty() || (blocks_.size() == 1 && blocks_[0].source == 0));
+}
+
+const std::shared_ptr< const ParameterLayout >& ParameterProjection::layout() const
+{
+  return layout_;
+}
+
+size_t ParameterProjection::dim() const
+{
+  return layout_->dim();
+}
+
+bool ParameterProjection::identity() const
+{
+  return identity_;
+}
+
+void ParameterProjection::apply(const double* source, double* target) const
+{
+  for (const auto& block : blocks_)
+    std::copy_n(source + block.source, block.size, target + block.target);
+}
+
+const double* ParameterProjection::map(const double* source, double* scratch) const
+{
+  if (identity_)
+    return source;
+  apply(source, scratch);
+  return scratch;
+}
+
+FlatParameter ParameterProjection::apply(const FlatParameter& mu) const
+{
+  std::vector< double > ret(dim());
+  apply(mu.data(), ret.data());
+  return FlatParameter(layout_, std::move(ret));
+}
+
+
 // ======================
 // ===== Parametric =====
 // ======================
 Parametric::Parametric()
   : type_()
+  , num_projections_(0)
 {}
 
 Parametric::Parametric(const ParameterType& tt)
   : type_(tt)
+  , num_projections_(0)
 {}
 
 Parametric::Parametric(const std::string& kk, const DUNE_STUFF_SSIZE_T & vv)
   : type_(kk, vv)
+  , num_projections_(0)
 {}
 
 Parametric::Parametric(const std::vector< std::string >& kk, const std::vector< DUNE_STUFF_SSIZE_T >& vv)
   : type_(kk, vv)
+  , num_projections_(0)
 {}
 
 Parametric::Parametric(const Parametric& other)
   : type_(other.type_)
   , inherits_map_(other.inherits_map_)
-{}
+  , inherits_ids_(other.inherits_ids_)
+  , num_projections_(0)
+{
+  std::lock_guard< std::mutex > lock(other.projections_mutex_);
+  projections_ = other.projections_;
+  projections_.reserve(inherits_ids_.size());
+  num_projections_ = projections_.size();
+}
+
+Parametric& Parametric::operator=(const Parametric& other)
+{
+  if (this != &other) {
+    type_ = other.type_;
+    inherits_map_ = other.inherits_map_;
+    inherits_ids_ = other.inherits_ids_;
+    std::lock_guard< std::mutex > lock(other.projections_mutex_);
+    projections_ = other.projections_;
+    projections_.reserve(inherits_ids_.size());
+    num_projections_ = projections_.size();
+  }
+  return *this;
+}
 
 Parametric::~Parametric()
 {}
@@ -487,7 +810,7 @@ bool Parametric::parametric() const
   return !parameter_type().empty();
 }
 
-void Parametric::inherit_parameter_type(const ParameterType& tt, const std::string id)
+size_t Parametric::inherit_parameter_type(const ParameterType& tt, const std::string id)
 {
   if (id.empty()) DUNE_THROW(Stuff::Exceptions::wrong_input_given, "id must not be empty!");
   const auto result = inherits_map_.find(id);
@@ -495,28 +818,71 @@ void Parametric::inherit_parameter_type(const ParameterType& tt, const std::stri
     DUNE_THROW(Stuff::Exceptions::wrong_input_given,
                "inheriting the same id twice with different types does not make any sense (type of tt is "
                << tt << ", while type " << result->second << " is already registered for '" << id << "'!");
+  const bool known_id = (result != inherits_map_.end());
   inherits_map_[id] = tt;
+  bool type_changed = false;
   for (auto key : tt.keys()) {
-    if (type_.hasKey(key) && (type_.get(key) != tt.get(key)))
-      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
-                 "the size for key '" << key << "' in tt (" << tt.get(key)
-                 << ") does not match the size for '" << key << "' in this parameter_type ("
-                 << type_.get(key) << ")!");
-    else
+    if (type_.hasKey(key)) {
+      if (type_.get(key) != tt.get(key))
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "the size for key '" << key << "' in tt (" << tt.get(key)
+                   << ") does not match the size for '" << key << "' in this parameter_type ("
+                   << type_.get(key) << ")!");
+    } else {
       type_.set(key, tt.get(key));
+      type_changed = true;
+    }
   }
+  if (!known_id)
+    inherits_ids_.push_back(id);
+  // the offsets of all inherited types change with the parameter type, the projections are rebuilt on first access
+  if (type_changed) {
+    projections_.clear();
+    num_projections_ = 0;
+  }
+  // update_projections() must not reallocate projections_ while it is read concurrently
+  projections_.reserve(inherits_ids_.size());
+  return std::find(inherits_ids_.begin(), inherits_ids_.end(), id) - inherits_ids_.begin();
+} // ... inherit_parameter_type(...)
+
+size_t Parametric::inherit_parameter_type(const Parameter& mu, const std::string id)
+{
+  return inherit_parameter_type(mu.type(), id);
 }
 
-void Parametric::inherit_parameter_type(const Parameter& mu, const std::string id)
+size_t Parametric::inherit_parameter_type(const Parametric& other, const std::string id)
 {
-  inherit_parameter_type(mu.type(), id);
+  return inherit_parameter_type(other.parameter_type(), id);
 }
 
-void Parametric::inherit_parameter_type(const Parametric& other, const std::string id)
+const ParameterProjection& Parametric::parameter_projection(const size_t index) const
 {
-  inherit_parameter_type(other.parameter_type(), id);
+  if (index >= inherits_ids_.size())
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+               "index has to be smaller than " << inherits_ids_.size() << " (is " << index << ")!");
+  if (index >= num_projections_.load(std::memory_order_acquire))
+    update_projections();
+  return *projections_[index];
 }
 
+const ParameterProjection& Parametric::parameter_projection(const std::string id) const
+{
+  const auto result = std::find(inherits_ids_.begin(), inherits_ids_.end(), id);
+  if (result == inherits_ids_.end())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << id << "' has not been inherited!");
+  return parameter_projection(size_t(result - inherits_ids_.begin()));
+}
+
+void Parametric::update_projections() const
+{
+  std::lock_guard< std::mutex > lock(projections_mutex_);
+  // the capacity of projections_ is reserved by inherit_parameter_type(), appending thus never reallocates
+  for (size_t ii = projections_.size(); ii < inherits_ids_.size(); ++ii)
+    projections_.emplace_back(std::make_shared< const ParameterProjection >(
+                                *type_.layout(), inherits_map_.at(inherits_ids_[ii]).layout()));
+  num_projections_.store(projections_.size(), std::memory_order_release);
+} // ... update_projections(...)
+
 Parameter Parametric::map_parameter(const Parameter& mu, const std::string id) const
 {
   const auto result = inherits_map_.find(id);
@@ -531,6 +897,27 @@ Parameter Parametric::map_parameter(const Parameter& mu, const std::string id) c
   }
 }
 
+FlatParameter Parametric::map_parameter(const FlatParameter& mu, const std::string id) const
+{
+  const auto result = inherits_map_.find(id);
+  if (result == inherits_map_.end())
+    return FlatParameter();
+  else if (mu.has_type(type_))
+    return parameter_projection(id).apply(mu);
+  else {
+    const auto& localLayout = result->second.layout();
+    const auto& globalLayout = *mu.layout();
+    const auto& localKeys = localLayout->keys();
+    const auto& localOffsets = localLayout->offsets();
+    std::vector< double > muLocal(localLayout->dim());
+    for (size_t ii = 0; ii < localKeys.size(); ++ii)
+      std::copy_n(mu.data() + globalLayout.offset(localKeys[ii]),
+                  localOffsets[ii + 1] - localOffsets[ii],
+                  muLocal.begin() + localOffsets[ii]);
+    return FlatParameter(localLayout, std::move(muLocal));
+  }
+}
+
 const ParameterType& Parametric::map_parameter_type(const std::string id) const
 {
   if (inherits_map_.empty())
@@ -562,6 +949,9 @@ const ParameterType& Parametric::map_parameter_type(const std::string id) const
 void Parametric::replace_parameter_type(const ParameterType tt)
 {
   inherits_map_.clear();
+  inherits_ids_.clear();
+  projections_.clear();
+  num_projections_ = 0;
   type_ = tt;
 }
 
@@ -8,7 +8,12 @@
 
 #include <string>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 #include <vector>
+#include <memory>
+#include <functional>
 #include <initializer_list>
 #include <sstream>
 #include <ostream>
@@ -64,6 +69,57 @@ protected:
 }; // class KeyValueBase
 
 
+/**
+ * \brief The position of each component of a ParameterType within a serialized parameter.
+ *
+ *        Stores the keys in the order of Parameter::serialize() together with the offset of each component, such that
+ *        the position of a component can be looked up in O(1). Each ParameterType creates its layout once, it is then
+ *        shared by all copies of the type and all FlatParameters of that type.
+ */
+class ParameterLayout
+{
+public:
+  ParameterLayout();
+
+  ParameterLayout(const std::vector< std::string >& kk, const std::vector< DUNE_STUFF_SSIZE_T >& vv);
+
+  const std::vector< std::string >& keys() const;
+
+  bool hasKey(const std::string& key) const;
+
+  /**
+   * \brief The index of key in keys().
+   */
+  size_t index(const std::string& key) const;
+
+  size_t offset(const std::string& key) const;
+
+  size_t size(const std::string& key) const;
+
+  /**
+   * \brief The offsets of all components, offsets()[keys().size()] coincides with dim().
+   */
+  const std::vector< size_t >& offsets() const;
+
+  /**
+   * \brief The length of a serialized parameter.
+   */
+  size_t dim() const;
+
+  size_t hash() const;
+
+  bool operator==(const ParameterLayout& other) const;
+
+  bool operator!=(const ParameterLayout& other) const;
+
+private:
+  std::vector< std::string > keys_;
+  std::vector< size_t > offsets_;
+  std::unordered_map< std::string, size_t > indices_;
+  size_t hash_;
+}; // class ParameterLayout
+
+
 /**
  * \brief Determines the type of any parameter as a set of components and their length.
  *
@@ -103,6 +159,8 @@ public:
 
   std::string report_for_filename() const;
 
+  const std::shared_ptr< const ParameterLayout >& layout() const;
+
   using BaseType::keys;
   using BaseType::values;
   using BaseType::hasKey;
@@ -110,6 +168,11 @@ public:
   using BaseType::operator==;
   using BaseType::operator!=;
   using BaseType::size;
+
+private:
+  void update_layout();
+
+  std::shared_ptr< const ParameterLayout > layout_;
 }; // class ParameterType
 
 
@@ -148,6 +211,16 @@ public:
 
   ValueType serialize() const;
 
+  /**
+   * \brief Overwrites all values from vv, given in the order of serialize(), keeping the type of this parameter.
+   *
+   *        Cheaper than calling set() for each key, since neither the keys nor the type have to be rebuilt.
+   */
+  void deserialize(const ValueType& vv);
+
+  //! as above, for size values given contiguously (e.g., from a python buffer, see Bindings::read_buffer())
+  void deserialize(const double* values, const size_t size);
+
   bool operator==(const double& value) const;
 
   bool operator==(const ValueType& values) const;
@@ -172,6 +245,118 @@ private:
 std::ostream& operator<<(std::ostream& oo, const Parameter& pp);
 
 
+/**
+ * \brief A Parameter stored as one contiguous buffer (in the order of Parameter::serialize()) and a shared layout.
+ *
+ *        Copying, comparing and hashing a FlatParameter does not touch any strings, the hash is computed once on
+ *        construction. Use this class as key for caches and in places where a Parameter is evaluated many times.
+ */
+class FlatParameter
+{
+public:
+  FlatParameter();
+
+  explicit FlatParameter(const Parameter& mu);
+
+  FlatParameter(const ParameterType& tt, const std::vector< double >& vv);
+
+  FlatParameter(const std::shared_ptr< const ParameterLayout >& layout, std::vector< double >&& vv);
+
+  const std::shared_ptr< const ParameterLayout >& layout() const;
+
+  /**
+   * \brief Checks if this is a parameter of type tt.
+   */
+  bool has_type(const ParameterType& tt) const;
+
+  const std::vector< double >& values() const;
+
+  const double* data() const;
+
+  size_t size() const;
+
+  /**
+   * \brief Returns a pointer to the first entry of the component key.
+   */
+  const double* get(const std::string& key) const;
+
+  size_t hash() const;
+
+  Parameter parameter() const;
+
+  std::string report() const;
+
+  bool operator==(const FlatParameter& other) const;
+
+  bool operator!=(const FlatParameter& other) const;
+
+  bool operator<(const FlatParameter& other) const;
+
+private:
+  std::shared_ptr< const ParameterLayout > layout_;
+  std::vector< double > values_;
+  size_t hash_;
+}; // class FlatParameter
+
+
+std::ostream& operator<<(std::ostream& oo, const FlatParameter& pp);
+
+
+/**
+ * \brief Maps a serialized parameter of one layout to a serialized parameter of a sub-layout.
+ *
+ *        The mapping is stored as a list of contiguous blocks, applying it is thus a plain gather without any key
+ *        lookups or allocations.
+ * \see   Parametric::map_parameter
+ */
+class ParameterProjection
+{
+public:
+  ParameterProjection(const ParameterLayout& source, const std::shared_ptr< const ParameterLayout >& target);
+
+  /**
+   * \brief The layout of the mapped parameter.
+   */
+  const std::shared_ptr< const ParameterLayout >& layout() const;
+
+  /**
+   * \brief The length of the mapped parameter.
+   */
+  size_t dim() const;
+
+  /**
+   * \brief True, if the source and the target layout coincide.
+   */
+  bool identity() const;
+
+  /**
+   * \brief Gathers the entries of source into target.
+   * \param target has to provide dim() entries
+   */
+  void apply(const double* source, double* target) const;
+
+  /**
+   * \brief Returns source if identity() is true, otherwise gathers the entries of source into scratch and returns it.
+   * \param scratch has to provide dim() entries
+   */
+  const double* map(const double* source, double* scratch) const;
+
+  FlatParameter apply(const FlatParameter& mu) const;
+
+private:
+  struct Block
+  {
+    size_t source;
+    size_t target;
+    size_t size;
+  };
+
+  std::shared_ptr< const ParameterLayout > layout_;
+  std::vector< Block > blocks_;
+  bool identity_;
+}; // class ParameterProjection
+
+
 /**
  * \brief Base class for everything that can possibly parametric.
  *
@@ -202,6 +387,8 @@ public:
 
   Parametric(const Parametric& other);
 
+  Parametric& operator=(const Parametric& other);
+
   virtual ~Parametric();
 
   const ParameterType& parameter_type() const;
@@ -209,25 +396,66 @@ public:
   bool parametric() const;
 
 protected:
-  void inherit_parameter_type(const ParameterType& tt, const std::string id);
+  /**
+   * \brief Inherits tt as the parameter type of id.
+   * \return The index of the ParameterProjection from parameter_type() to tt, \see parameter_projection()
+   */
+  size_t inherit_parameter_type(const ParameterType& tt, const std::string id);
+
+  size_t inherit_parameter_type(const Parameter& mu, const std::string id);
 
-  void inherit_parameter_type(const Parameter& mu, const std::string id);
+  size_t inherit_parameter_type(const Parametric& other, const std::string id);
 
-  void inherit_parameter_type(const Parametric& other, const std::string id);
+  /**
+   * \brief The projection from parameter_type() to the type inherited with the given index.
+   */
+  const ParameterProjection& parameter_projection(const size_t index) const;
+
+  const ParameterProjection& parameter_projection(const std::string id) const;
 
   const ParameterType& map_parameter_type(const std::string id) const;
 
   Parameter map_parameter(const Parameter& mu, const std::string id) const;
 
+  FlatParameter map_parameter(const FlatParameter& mu, const std::string id) const;
+
   void replace_parameter_type(const ParameterType tt = ParameterType());
 
 private:
+  /**
+   * \brief Builds the projections of all inherited types which do not have one yet.
+   *
+   *        Any change of parameter_type() invalidates all projections, they are thus only built on first access after
+   *        the last call to inherit_parameter_type() instead of once per call. Safe to call concurrently.
+   */
+  void update_projections() const;
+
   ParameterType type_;
   std::map< std::string, ParameterType > inherits_map_;
+  std::vector< std::string > inherits_ids_;
+  //! the projections are never moved, references to them stay valid until the next change of parameter_type()
+  mutable std::vector< std::shared_ptr< const ParameterProjection > > projections_;
+  mutable std::atomic< size_t > num_projections_;
+  mutable std::mutex projections_mutex_;
 }; // class Parametric
 
 
 } // namespace Pymor
 } // namespace Dune
 
+namespace std {
+
+
+template<>
+struct hash< Dune::Pymor::FlatParameter >
+{
+  size_t operator()(const Dune::Pymor::FlatParameter& mu) const
+  {
+    return mu.hash();
+  }
+}; // struct hash< Dune::Pymor::FlatParameter >
+
+
+} // namespace std
+
 #endif // DUNE_PYMOR_PARAMETERS_BASE_HH
@@ -76,6 +76,7 @@ def inject_Parameter(module, exceptions, CONFIG_H):
     Parameter.add_constructor([param('Dune::Pymor::ParameterType', 'tt'),
                                param('std::vector< std::vector< double > >', 'vv')],
                               throw=exceptions)
+    Parameter.add_copy_constructor()
     Parameter.add_method('type', retval('Dune::Pymor::ParameterType'), [], is_const=True)
     Parameter.add_method('empty', retval('bool'), [], is_const=True)
     Parameter.add_method('keys',
@@ -100,11 +101,36 @@ def inject_Parameter(module, exceptions, CONFIG_H):
                          [param('std::string', 'key')],
                          is_const=True,
                          throw=exceptions)
+    Parameter.add_method('serialize', retval('std::vector< double >'), [], is_const=True)
+    # takes a contiguous one dimensional buffer of doubles (e.g., a numpy array), see Dune::Pymor::Bindings::read_buffer
+    wrapper_name = '_wrap_' + Parameter.pystruct + '_deserialize'
+    Parameter.add_custom_method_wrapper(
+        'deserialize',
+        wrapper_name,
+        ('PyObject* ' + wrapper_name + '(' + Parameter.pystruct + ' *self, PyObject *args, PyObject *kwargs,\n'
+         '    PyObject **PYBINDGEN_UNUSED(return_exception))\n'
+         '{\n'
+         '  PyObject* values;\n'
+         '  const char* keywords[] = {"values", NULL};\n'
+         '  if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char*)"O", (char**)keywords, &values))\n'
+         '    return NULL;\n'
+         '  try {\n'
+         '    Dune::Pymor::Bindings::read_buffer(values, [&](const double* data, const size_t size) {\n'
+         '      self->obj->deserialize(data, size);\n'
+         '    });\n'
+         '  } catch (Dune::Exception& ee) {\n'
+         '    PyErr_SetString(PyExc_ValueError, std::string(ee.what()).c_str());\n'
+         '    return NULL;\n'
+         '  }\n'
+         '  Py_RETURN_NONE;\n'
+         '}'),
+        flags=['METH_VARARGS', 'METH_KEYWORDS'])
     Parameter.add_binary_comparison_operator('==')
     Parameter.add_binary_comparison_operator('!=')
     Parameter.add_method('size', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True)
     Parameter.add_method('report', retval('std::string'), [], is_const=True)
     Parameter.allow_subclassing = True
+    module.add_container('std::vector< Dune::Pymor::Parameter >', 'Dune::Pymor::Parameter', 'list')
     return module, Parameter
 
 
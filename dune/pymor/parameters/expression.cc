@@ -0,0 +1,406 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cmath>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <algorithm>
+
+#include "expression.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+namespace {
+
+
+/**
+ * \brief Recursive descent parser which emits the instructions in postfix order.
+ *
+ *        The grammar is
+\code
+expression := term (('+' | '-') term)*
+term       := unary (('*' | '/') unary)*
+unary      := ('+' | '-') unary | power
+power      := primary ('^' unary)?
+primary    := number | '(' expression ')' | name '(' expression (',' expression)? ')' | name ('[' integer ']')?
+\endcode
+ *        Any parse error (including unknown variables or functions) sets failed_.
+ */
+class TapeBuilder
+{
+  typedef CompiledExpression::OpCode OpCode;
+  typedef CompiledExpression::Instruction Instruction;
+
+public:
+  TapeBuilder(const std::string& expression, const ParameterType& type)
+    : pos_(expression.c_str())
+    , failed_(false)
+  {
+    size_t offset = 0;
+    for (const auto& key : type.keys()) {
+      const size_t size = type.get(key);
+      offsets_[key] = std::make_pair(offset, size);
+      offset += size;
+    }
+    num_arguments_ = offset;
+  }
+
+  bool build()
+  {
+    parse_expression();
+    skip_whitespace();
+    if (*pos_ != '\0')
+      failed_ = true;
+    return !failed_ && !tape_.empty();
+  }
+
+  std::vector< Instruction >& tape()
+  {
+    return tape_;
+  }
+
+  size_t num_arguments() const
+  {
+    return num_arguments_;
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (std::isspace(static_cast< unsigned char >(*pos_)))
+      ++pos_;
+  }
+
+  bool accept(const char cc)
+  {
+    skip_whitespace();
+    if (*pos_ == cc) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(const char cc)
+  {
+    if (!accept(cc))
+      failed_ = true;
+  }
+
+  void emit(const OpCode code, const size_t index = 0, const double value = 0.0)
+  {
+    tape_.push_back({code, index, value});
+  }
+
+  void parse_expression()
+  {
+    parse_term();
+    while (!failed_) {
+      if (accept('+')) {
+        parse_term();
+        emit(OpCode::add);
+      } else if (accept('-')) {
+        parse_term();
+        emit(OpCode::sub);
+      } else
+        break;
+    }
+  } // ... parse_expression()
+
+  void parse_term()
+  {
+    parse_unary();
+    while (!failed_) {
+      if (accept('*')) {
+        parse_unary();
+        emit(OpCode::mul);
+      } else if (accept('/')) {
+        parse_unary();
+        emit(OpCode::div);
+      } else
+        break;
+    }
+  } // ... parse_term()
+
+  void parse_unary()
+  {
+    if (failed_)
+      return;
+    if (accept('-')) {
+      parse_unary();
+      emit(OpCode::neg);
+    } else if (accept('+'))
+      parse_unary();
+    else
+      parse_power();
+  } // ... parse_unary()
+
+  void parse_power()
+  {
+    parse_primary();
+    if (!failed_ && accept('^')) {
+      parse_unary();
+      emit(OpCode::pow);
+    }
+  } // ... parse_power()
+
+  void parse_primary()
+  {
+    if (failed_)
+      return;
+    skip_whitespace();
+    if (accept('(')) {
+      parse_expression();
+      expect(')');
+    } else if (std::isdigit(static_cast< unsigned char >(*pos_)) || *pos_ == '.') {
+      char* end = nullptr;
+      const double value = std::strtod(pos_, &end);
+      if (end == pos_)
+        failed_ = true;
+      else {
+        pos_ = end;
+        emit(OpCode::constant, 0, value);
+      }
+    } else if (std::isalpha(static_cast< unsigned char >(*pos_)) || *pos_ == '_') {
+      const char* begin = pos_;
+      while (std::isalnum(static_cast< unsigned char >(*pos_)) || *pos_ == '_')
+        ++pos_;
+      const std::string name(begin, pos_);
+      if (accept('('))
+        parse_call(name);
+      else
+        parse_variable(name);
+    } else
+      failed_ = true;
+  } // ... parse_primary()
+
+  void parse_call(const std::string& name)
+  {
+    static const std::map< std::string, OpCode > unary_functions = {{"abs", OpCode::abs},
+                                                                    {"sqrt", OpCode::sqrt},
+                                                                    {"exp", OpCode::exp},
+                                                                    {"log", OpCode::log},
+                                                                    {"sin", OpCode::sin},
+                                                                    {"cos", OpCode::cos},
+                                                                    {"tan", OpCode::tan},
+                                                                    {"asin", OpCode::asin},
+                                                                    {"acos", OpCode::acos},
+                                                                    {"atan", OpCode::atan},
+                                                                    {"sinh", OpCode::sinh},
+                                                                    {"cosh", OpCode::cosh},
+                                                                    {"tanh", OpCode::tanh}};
+    static const std::map< std::string, OpCode > binary_functions = {{"min", OpCode::min},
+                                                                     {"max", OpCode::max},
+                                                                     {"pow", OpCode::pow}};
+    const auto unary = unary_functions.find(name);
+    const auto binary = binary_functions.find(name);
+    parse_expression();
+    if (unary != unary_functions.end()) {
+      expect(')');
+      emit(unary->second);
+    } else if (binary != binary_functions.end()) {
+      expect(',');
+      parse_expression();
+      expect(')');
+      emit(binary->second);
+    } else
+      failed_ = true;
+  } // ... parse_call(...)
+
+  void parse_variable(const std::string& name)
+  {
+    const auto search = offsets_.find(name);
+    if (search == offsets_.end()) {
+      failed_ = true;
+      return;
+    }
+    const size_t offset = search->second.first;
+    const size_t size = search->second.second;
+    size_t index = 0;
+    if (accept('[')) {
+      skip_whitespace();
+      if (!std::isdigit(static_cast< unsigned char >(*pos_))) {
+        failed_ = true;
+        return;
+      }
+      char* end = nullptr;
+      index = std::strtoul(pos_, &end, 10);
+      pos_ = end;
+      expect(']');
+    } else if (size != 1)
+      failed_ = true;
+    if (index >= size)
+      failed_ = true;
+    if (!failed_)
+      emit(OpCode::variable, offset + index);
+  } // ... parse_variable(...)
+
+  const char* pos_;
+  bool failed_;
+  size_t num_arguments_;
+  std::map< std::string, std::pair< size_t, size_t > > offsets_;
+  std::vector< Instruction > tape_;
+}; // class TapeBuilder
+
+
+size_t required_stack_size(const std::vector< CompiledExpression::Instruction >& tape)
+{
+  typedef CompiledExpression::OpCode OpCode;
+  size_t current = 0;
+  size_t required = 0;
+  for (const auto& instruction : tape) {
+    switch (instruction.code) {
+      case OpCode::constant:
+      case OpCode::variable:
+        ++current;
+        break;
+      case OpCode::add:
+      case OpCode::sub:
+      case OpCode::mul:
+      case OpCode::div:
+      case OpCode::pow:
+      case OpCode::min:
+      case OpCode::max:
+        --current;
+        break;
+      default:
+        break;
+    }
+    required = std::max(required, current);
+  }
+  assert(current == 1 && "This should not happen!");
+  return required;
+} // ... required_stack_size(...)
+
+
+} // namespace
+
+
+const size_t CompiledExpression::max_stack_size;
+const size_t CompiledExpression::block_size;
+
+std::shared_ptr< const CompiledExpression > CompiledExpression::compile(const std::string& expression,
+                                                                        const ParameterType& type)
+{
+  TapeBuilder builder(expression, type);
+  if (!builder.build())
+    return nullptr;
+  const size_t stack_size = required_stack_size(builder.tape());
+  if (stack_size > max_stack_size)
+    return nullptr;
+  return std::shared_ptr< const CompiledExpression >(
+        new CompiledExpression(std::move(builder.tape()), builder.num_arguments(), stack_size));
+} // ... compile(...)
+
+CompiledExpression::CompiledExpression(std::vector< Instruction >&& tape,
+                                       const size_t num_arguments,
+                                       const size_t stack_size)
+  : tape_(std::move(tape))
+  , num_arguments_(num_arguments)
+  , stack_size_(stack_size)
+{}
+
+size_t CompiledExpression::num_arguments() const
+{
+  return num_arguments_;
+}
+
+size_t CompiledExpression::stack_size() const
+{
+  return stack_size_;
+}
+
+double CompiledExpression::evaluate(const double* arguments) const
+{
+  double stack[max_stack_size];
+  size_t top = 0;
+  for (const auto& instruction : tape_) {
+    switch (instruction.code) {
+      case OpCode::constant: stack[top++] = instruction.value; break;
+      case OpCode::variable: stack[top++] = arguments[instruction.index]; break;
+      case OpCode::add: --top; stack[top - 1] += stack[top]; break;
+      case OpCode::sub: --top; stack[top - 1] -= stack[top]; break;
+      case OpCode::mul: --top; stack[top - 1] *= stack[top]; break;
+      case OpCode::div: --top; stack[top - 1] /= stack[top]; break;
+      case OpCode::pow: --top; stack[top - 1] = std::pow(stack[top - 1], stack[top]); break;
+      case OpCode::min: --top; stack[top - 1] = std::min(stack[top - 1], stack[top]); break;
+      case OpCode::max: --top; stack[top - 1] = std::max(stack[top - 1], stack[top]); break;
+      case OpCode::neg: stack[top - 1] = -stack[top - 1]; break;
+      case OpCode::abs: stack[top - 1] = std::abs(stack[top - 1]); break;
+      case OpCode::sqrt: stack[top - 1] = std::sqrt(stack[top - 1]); break;
+      case OpCode::exp: stack[top - 1] = std::exp(stack[top - 1]); break;
+      case OpCode::log: stack[top - 1] = std::log(stack[top - 1]); break;
+      case OpCode::sin: stack[top - 1] = std::sin(stack[top - 1]); break;
+      case OpCode::cos: stack[top - 1] = std::cos(stack[top - 1]); break;
+      case OpCode::tan: stack[top - 1] = std::tan(stack[top - 1]); break;
+      case OpCode::asin: stack[top - 1] = std::asin(stack[top - 1]); break;
+      case OpCode::acos: stack[top - 1] = std::acos(stack[top - 1]); break;
+      case OpCode::atan: stack[top - 1] = std::atan(stack[top - 1]); break;
+      case OpCode::sinh: stack[top - 1] = std::sinh(stack[top - 1]); break;
+      case OpCode::cosh: stack[top - 1] = std::cosh(stack[top - 1]); break;
+      case OpCode::tanh: stack[top - 1] = std::tanh(stack[top - 1]); break;
+    }
+  }
+  assert(top == 1);
+  return stack[0];
+} // ... evaluate(...)
+
+void CompiledExpression::evaluate(const double* arguments, const size_t num_parameters, double* results) const
+{
+  double stack[max_stack_size][block_size];
+  for (size_t begin = 0; begin < num_parameters; begin += block_size) {
+    const size_t nn = std::min(block_size, num_parameters - begin);
+    const double* block_arguments = arguments + begin * num_arguments_;
+    size_t top = 0;
+    for (const auto& instruction : tape_) {
+      double* rhs = stack[top > 0 ? top - 1 : 0];
+      double* lhs = stack[top > 1 ? top - 2 : 0];
+      switch (instruction.code) {
+        case OpCode::constant:
+          std::fill(stack[top], stack[top] + nn, instruction.value);
+          ++top;
+          break;
+        case OpCode::variable:
+          for (size_t ii = 0; ii < nn; ++ii)
+            stack[top][ii] = block_arguments[ii * num_arguments_ + instruction.index];
+          ++top;
+          break;
+        case OpCode::add: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] += rhs[ii]; --top; break;
+        case OpCode::sub: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] -= rhs[ii]; --top; break;
+        case OpCode::mul: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] *= rhs[ii]; --top; break;
+        case OpCode::div: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] /= rhs[ii]; --top; break;
+        case OpCode::pow: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] = std::pow(lhs[ii], rhs[ii]); --top; break;
+        case OpCode::min: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] = std::min(lhs[ii], rhs[ii]); --top; break;
+        case OpCode::max: for (size_t ii = 0; ii < nn; ++ii) lhs[ii] = std::max(lhs[ii], rhs[ii]); --top; break;
+        case OpCode::neg: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = -rhs[ii]; break;
+        case OpCode::abs: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::abs(rhs[ii]); break;
+        case OpCode::sqrt: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::sqrt(rhs[ii]); break;
+        case OpCode::exp: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::exp(rhs[ii]); break;
+        case OpCode::log: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::log(rhs[ii]); break;
+        case OpCode::sin: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::sin(rhs[ii]); break;
+        case OpCode::cos: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::cos(rhs[ii]); break;
+        case OpCode::tan: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::tan(rhs[ii]); break;
+        case OpCode::asin: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::asin(rhs[ii]); break;
+        case OpCode::acos: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::acos(rhs[ii]); break;
+        case OpCode::atan: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::atan(rhs[ii]); break;
+        case OpCode::sinh: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::sinh(rhs[ii]); break;
+        case OpCode::cosh: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::cosh(rhs[ii]); break;
+        case OpCode::tanh: for (size_t ii = 0; ii < nn; ++ii) rhs[ii] = std::tanh(rhs[ii]); break;
+      }
+    }
+    assert(top == 1);
+    std::copy(stack[0], stack[0] + nn, results + begin);
+  }
+} // ... evaluate(...)
+
+
+} // namespace internal
+} // namespace Pymor
+} // namespace Dune
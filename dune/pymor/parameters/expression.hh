@@ -0,0 +1,89 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_PARAMETERS_EXPRESSION_HH
+#define DUNE_PYMOR_PARAMETERS_EXPRESSION_HH
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "base.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+/**
+ * \brief A flat instruction tape for the expression of a ParameterFunctional.
+ *
+ *        The expression is parsed once and translated into a sequence of instructions for a small stack machine, where
+ *        each variable is resolved to its position in the serialized parameter (see Parameter::serialize()). Evaluating
+ *        the tape only reads the given arguments and uses a fixed size stack, it is thus reentrant and does not
+ *        allocate.
+ *
+ *        Supported are floating point numbers, the variables of the ParameterType (components of size 1 may also be
+ *        used without []), the binary operators +, -, *, / and ^, unary + and -, parentheses and the functions abs,
+ *        sqrt, exp, log, sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, min, max and pow. For any other
+ *        expression compile() returns nullptr, in which case the caller has to fall back to the interpreted evaluation.
+ */
+class CompiledExpression
+{
+public:
+  static const size_t max_stack_size = 32;
+  static const size_t block_size = 64;
+
+  static std::shared_ptr< const CompiledExpression > compile(const std::string& expression, const ParameterType& type);
+
+  size_t num_arguments() const;
+
+  size_t stack_size() const;
+
+  /**
+   * \brief Evaluates the tape for one serialized parameter.
+   * \param arguments has to provide num_arguments() entries.
+   */
+  double evaluate(const double* arguments) const;
+
+  /**
+   * \brief Evaluates the tape for num_parameters serialized parameters at once.
+   *
+   *        The instructions are applied to blocks of block_size parameters, such that each instruction is a tight loop
+   *        over the block which the compiler may vectorize.
+   * \param arguments has to provide num_parameters * num_arguments() entries (one serialized parameter per row)
+   * \param results   has to provide num_parameters entries
+   */
+  void evaluate(const double* arguments, const size_t num_parameters, double* results) const;
+
+  enum class OpCode
+  {
+    constant, variable,
+    add, sub, mul, div, pow, neg,
+    abs, sqrt, exp, log, sin, cos, tan, asin, acos, atan, sinh, cosh, tanh,
+    min, max
+  };
+
+  struct Instruction
+  {
+    OpCode code;
+    size_t index;
+    double value;
+  };
+
+private:
+  CompiledExpression(std::vector< Instruction >&& tape, const size_t num_arguments, const size_t stack_size);
+
+  const std::vector< Instruction > tape_;
+  const size_t num_arguments_;
+  const size_t stack_size_;
+}; // class CompiledExpression
+
+
+} // namespace internal
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_PARAMETERS_EXPRESSION_HH
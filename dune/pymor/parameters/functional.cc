@@ -7,9 +7,11 @@
 
 #include <limits>
 #include <sstream>
+#include <mutex>
 
 #include <dune/stuff/common/print.hh>
 #include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/expression/mathexpr.hh>
 
 #include <dune/pymor/common/exceptions.hh>
 
@@ -17,12 +19,53 @@
 
 namespace Dune {
 namespace Pymor {
+namespace internal {
+
+
+/**
+ * \brief Wraps the interpreter of mathexpr for expressions which can not be compiled.
+ *
+ *        The interpreter reads its variables from the storage given to the RVars, evaluating is thus guarded by a
+ *        mutex.
+ */
+class InterpretedExpression
+{
+public:
+  InterpretedExpression(const std::string& expression, const std::vector< std::string >& variables)
+    : arguments_(variables.size(), 0.0)
+  {
+    for (size_t ii = 0; ii < variables.size(); ++ii) {
+      variables_.emplace_back(new RVar(variables[ii].c_str(), &(arguments_[ii])));
+      vararray_.push_back(variables_[ii].get());
+    }
+    op_ = std::unique_ptr< ROperation >(new ROperation(expression.c_str(), int(vararray_.size()), vararray_.data()));
+  }
+
+  void evaluate(const double* arguments, const size_t num_parameters, double* results)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    for (size_t nn = 0; nn < num_parameters; ++nn) {
+      std::copy(arguments + nn * arguments_.size(), arguments + (nn + 1) * arguments_.size(), arguments_.begin());
+      results[nn] = op_->Val();
+    }
+  }
+
+private:
+  std::vector< double > arguments_;
+  std::vector< std::unique_ptr< RVar > > variables_;
+  std::vector< RVar* > vararray_;
+  std::unique_ptr< ROperation > op_;
+  std::mutex mutex_;
+}; // class InterpretedExpression
+
+
+} // namespace internal
 
 
 ParameterFunctional::ParameterFunctional(const ParameterType& tt, const std::string& exp)
   : Parametric(tt)
   , expression_(exp)
-  , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , actual_size_(0)
 {
   setup();
 }
@@ -32,7 +75,7 @@ ParameterFunctional::ParameterFunctional(const std::string& kk,
                                          const std::string& exp)
   : Parametric(ParameterType(kk, vv))
   , expression_(exp)
-  , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , actual_size_(0)
 {
   setup();
 }
@@ -42,7 +85,7 @@ ParameterFunctional::ParameterFunctional(const std::vector< std::string >& kk,
                                          const std::string& exp)
   : Parametric(ParameterType(kk, vv))
   , expression_(exp)
-  , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , actual_size_(0)
 {
   setup();
 }
@@ -50,23 +93,24 @@ ParameterFunctional::ParameterFunctional(const std::vector< std::string >& kk,
 ParameterFunctional::ParameterFunctional(const ParameterFunctional& other)
   : Parametric(other.parameter_type())
   , expression_(other.expression_)
-  , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
-{
-  setup();
-}
+  , actual_size_(other.actual_size_)
+  , variables_(other.variables_)
+  , compiled_(other.compiled_)
+  , interpreted_(other.interpreted_)
+{}
 
 ParameterFunctional::~ParameterFunctional()
-{
-  cleanup();
-}
+{}
 
 ParameterFunctional& ParameterFunctional::operator=(const ParameterFunctional& other)
 {
   if (this != &other) {
-    cleanup();
     replace_parameter_type(other.parameter_type());
     expression_ = other.expression_;
-    setup();
+    actual_size_ = other.actual_size_;
+    variables_ = other.variables_;
+    compiled_ = other.compiled_;
+    interpreted_ = other.interpreted_;
   }
   return *this;
 }
@@ -97,75 +141,122 @@ void ParameterFunctional::evaluate(const Parameter& mu, double& ret) const
     DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
                "the type of mu (" << mu.type().report() << ") does not match the parameter_type of this ("
                << parameter_type().report() << ")!");
-  // parse argument
   const auto serialized_mu = mu.serialize();
   assert(serialized_mu.size() == actual_size_);
-  for (size_t ii = 0; ii < actual_size_; ++ii)
-    *(arg_[ii]) = serialized_mu[ii];
-  // copy ret
-  ret = op_->Val();
-  // perform sanity check
+  evaluate(serialized_mu.data(), serialized_mu.size(), ret);
+} // ... evaluate(...)
+
+double ParameterFunctional::evaluate(const Parameter& mu) const
+{
+  double ret = 0.0;
+  evaluate(mu, ret);
+  return ret;
+}
+
+void ParameterFunctional::evaluate(const FlatParameter& mu, double& ret) const
+{
+  if (!mu.has_type(parameter_type()))
+    DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+               "the type of mu (" << mu.parameter().type().report() << ") does not match the parameter_type of this ("
+               << parameter_type().report() << ")!");
+  evaluate(mu.data(), mu.size(), ret);
+} // ... evaluate(...)
+
+double ParameterFunctional::evaluate(const FlatParameter& mu) const
+{
+  double ret = 0.0;
+  evaluate(mu, ret);
+  return ret;
+}
+
+void ParameterFunctional::evaluate(const double* mu, const size_t size, double& ret) const
+{
+  if (size != actual_size_)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the given mu has " << size << " entries, but this functional has " << actual_size_ << " variables!");
+  if (compiled_)
+    ret = compiled_->evaluate(mu);
+  else
+    interpreted_->evaluate(mu, 1, &ret);
+  check_result(mu, ret);
+} // ... evaluate(...)
+
+double ParameterFunctional::evaluate(const double* mu, const size_t size) const
+{
+  double ret = 0.0;
+  evaluate(mu, size, ret);
+  return ret;
+}
+
+void ParameterFunctional::evaluate_batch(const double* mus,
+                                         const size_t num_mus,
+                                         const size_t size,
+                                         double* ret) const
+{
+  if (size != actual_size_)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the given mus have " << size << " entries each, but this functional has " << actual_size_
+               << " variables!");
+  if (compiled_)
+    compiled_->evaluate(mus, num_mus, ret);
+  else
+    interpreted_->evaluate(mus, num_mus, ret);
+  for (size_t nn = 0; nn < num_mus; ++nn)
+    check_result(mus + nn * size, ret[nn]);
+} // ... evaluate_batch(...)
+
+std::vector< double > ParameterFunctional::evaluate_batch(const std::vector< double >& mus) const
+{
+  if (actual_size_ == 0 || mus.size() % actual_size_ != 0)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of mus (" << mus.size() << ") has to be a multiple of the number of variables ("
+               << actual_size_ << ")!");
+  const size_t num_mus = mus.size() / actual_size_;
+  std::vector< double > ret(num_mus, 0.0);
+  evaluate_batch(mus.data(), num_mus, actual_size_, ret.data());
+  return ret;
+} // ... evaluate_batch(...)
+
+bool ParameterFunctional::compiled() const
+{
+  return bool(compiled_);
+}
+
+void ParameterFunctional::check_result(const double* mu, const double& ret) const
+{
   if (std::abs(ret) > (0.9 * std::numeric_limits< double >::max())) {
     std::stringstream ss;
     for (size_t ii = 0; ii < actual_size_; ++ii)
-      ss << "  " << variables_[ii] << std::endl;
+      ss << "  " << (*variables_)[ii] << " = " << mu[ii] << std::endl;
     DUNE_THROW(Stuff::Exceptions::internal_error,
                "evaluating this functional yielded an unlikely value!\n"
                << "The parameter_type() of this functional is:\n  " << parameter_type() << "\n"
-               << "The variables of this functional are:\n" << ss.str()
                << "The expression of this functional is:\n  " << expression_ << "\n"
-               << "You tried to evaluate it with:\n  mu = " << mu << "\n"
+               << "You tried to evaluate it with:\n" << ss.str()
                << "The result was:\n  " << ret);
   }
-} // ... evaluate(...)
-
-double ParameterFunctional::evaluate(const Parameter& mu) const
-{
-  double ret = 0.0;
-  evaluate(mu, ret);
-  return ret;
-}
+} // ... check_result(...)
 
 void ParameterFunctional::setup()
 {
   // create variables from parameter type
   const ParameterType& type = parameter_type();
+  std::vector< std::string > variables;
   for (auto variable_prefix : type.keys()) {
     const size_t variable_size = type.get(variable_prefix);
     for (size_t ii = 0; ii < variable_size; ++ii) {
       std::stringstream ss;
       ss << variable_prefix << "[" << ii << "]";
-      variables_.push_back(ss.str());
+      variables.push_back(ss.str());
     }
   }
-  actual_size_ = variables_.size();
-  if (actual_size_ > DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
-    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
-               "the given ParameterType requires " << variables_.size()
-               << " variables, but DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE is "
-               << DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE
-               << "! Recompile with larger DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE!");
-  for (size_t ii = variables_.size(); ii < DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE; ++ii)
-    variables_.push_back("this_is_a_dummy_expression");
-  assert(variables_.size() == DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE && "This should not happen!");
-  // create epressions
-  for (size_t ii = 0; ii < variables_.size(); ++ii) {
-    arg_[ii] = new double(0.0);
-    var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_[ii]);
-    vararray_[ii] = var_arg_[ii];
-  }
-  // build operation
-  op_ = new ROperation(expression_.c_str(), DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE, vararray_);
-} // void setup(const std::string& _variable, const std::vector< std::string >& expressions)
-
-void ParameterFunctional::cleanup()
-{
-  delete op_;
-  for (size_t ii = 0; ii < DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE; ++ii) {
-    delete var_arg_[ii];
-    delete arg_[ii];
-  }
-} // void cleanup()
+  actual_size_ = variables.size();
+  // compile, if possible, and only fall back to the interpreter otherwise
+  compiled_ = internal::CompiledExpression::compile(expression_, type);
+  if (!compiled_)
+    interpreted_ = std::make_shared< internal::InterpretedExpression >(expression_, variables);
+  variables_ = std::make_shared< const std::vector< std::string > >(std::move(variables));
+} // ... setup()
 
 
 } // namespace Pymor
@@ -9,22 +9,28 @@
 #include <vector>
 #include <memory>
 
-#include <dune/stuff/functions/expression/mathexpr.hh>
-
 #include "base.hh"
-
-#ifndef DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE
-#define DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE 64
-#endif
+#include "expression.hh"
 
 namespace Dune {
 namespace Pymor {
+namespace internal {
+
+
+class InterpretedExpression;
+
+
+} // namespace internal
 
 
 /**
  * \note Given a ParameterType with keys "foo" and "bar" of sizes 2 and 1, respectively, there are the following
  *       variables available for the expression: foo[0], foo[1] and bar[0]. Note that scalar parameter components are
  *       also indexed by []!
+ * \note  Most expressions (see internal::CompiledExpression) are compiled once during construction, evaluating those is
+ *        reentrant and may be done concurrently from several threads. Any other expression is evaluated by the
+ *        interpreter of mathexpr, which is guarded by a mutex.
+ * \note  Copies share the compiled (or interpreted) expression.
  */
 class ParameterFunctional
   : public Parametric
@@ -56,18 +62,47 @@ public:
 
   double evaluate(const Parameter& mu) const;
 
+  void evaluate(const FlatParameter& mu, double& ret) const;
+
+  double evaluate(const FlatParameter& mu) const;
+
+  /**
+   * \brief Evaluates the functional for a serialized parameter (see Parameter::serialize()).
+   * \param mu   has to provide size entries
+   * \param size has to coincide with the length of the serialized parameter, i.e. the number of variables
+   */
+  void evaluate(const double* mu, const size_t size, double& ret) const;
+
+  double evaluate(const double* mu, const size_t size) const;
+
+  /**
+   * \brief Evaluates the functional for num_mus serialized parameters at once.
+   * \param mus  has to provide num_mus * size entries (one serialized parameter per row)
+   * \param size has to coincide with the length of the serialized parameter, i.e. the number of variables
+   * \param ret  has to provide num_mus entries
+   */
+  void evaluate_batch(const double* mus, const size_t num_mus, const size_t size, double* ret) const;
+
+  /**
+   * \brief Evaluates the functional for all serialized parameters which are stored one after another in mus.
+   */
+  std::vector< double > evaluate_batch(const std::vector< double >& mus) const;
+
+  /**
+   * \brief Returns true, if the expression could be compiled and evaluate() does not require any locking.
+   */
+  bool compiled() const;
+
 private:
   void setup();
 
-  void cleanup();
+  void check_result(const double* mu, const double& ret) const;
 
   std::string expression_;
   size_t actual_size_;
-  std::vector< std::string > variables_;
-  mutable double* arg_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
-  RVar* var_arg_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
-  RVar* vararray_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
-  ROperation* op_;
+  std::shared_ptr< const std::vector< std::string > > variables_;
+  std::shared_ptr< const internal::CompiledExpression > compiled_;
+  std::shared_ptr< internal::InterpretedExpression > interpreted_;
 }; // class ParameterFunctional
 
 
@@ -33,5 +33,10 @@ def inject_ParameterFunctional(module, exceptions, interfaces, CONFIG_H):
                                    [param('const Parameter&', 'mu')],
                                    throw=exceptions,
                                    is_const=True)
+    ParameterFunctional.add_method('evaluate_batch',
+                                   retval('std::vector< double >'),
+                                   [param('const std::vector< double >&', 'mus')],
+                                   throw=exceptions,
+                                   is_const=True)
     ParameterFunctional.allow_subclassing = True
     return module, ParameterFunctional
@@ -0,0 +1,278 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <limits>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include "sampling.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+/**
+ * \brief The primitive polynomials and initial direction numbers of the Sobol sequence for the directions 2 to 21,
+ *        taken from new-joe-kuo-6.21201 (S. Joe, F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional
+ *        projections", SIAM J. Sci. Comput. 30, 2008).
+ */
+struct SobolDirection
+{
+  unsigned degree;
+  uint32_t coefficients;
+  uint32_t initial[7];
+};
+
+static const SobolDirection sobol_directions[] = {
+  {1, 0, {1}},
+  {2, 1, {1, 3}},
+  {3, 1, {1, 3, 1}},
+  {3, 2, {1, 1, 1}},
+  {4, 1, {1, 1, 3, 3}},
+  {4, 4, {1, 3, 5, 13}},
+  {5, 2, {1, 1, 5, 5, 17}},
+  {5, 4, {1, 1, 5, 5, 5}},
+  {5, 7, {1, 1, 7, 11, 19}},
+  {5, 11, {1, 1, 5, 1, 1}},
+  {5, 13, {1, 1, 1, 3, 11}},
+  {5, 14, {1, 3, 5, 5, 31}},
+  {6, 1, {1, 3, 3, 9, 7, 49}},
+  {6, 13, {1, 1, 1, 15, 21, 21}},
+  {6, 16, {1, 3, 1, 13, 27, 49}},
+  {6, 19, {1, 1, 1, 15, 7, 5}},
+  {6, 22, {1, 3, 1, 15, 13, 25}},
+  {6, 25, {1, 1, 5, 5, 19, 61}},
+  {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+  {7, 4, {1, 3, 7, 13, 13, 15, 69}}
+};
+
+static const size_t sobol_bits = 32;
+static const size_t sobol_max_dim = 1 + sizeof(sobol_directions) / sizeof(SobolDirection);
+
+
+//! the direction numbers V[ii] of direction dd, scaled to sobol_bits bits
+static std::vector< uint32_t > sobol_direction_numbers(const size_t dd)
+{
+  std::vector< uint32_t > ret(sobol_bits + 1, 0);
+  if (dd == 0) {
+    for (size_t ii = 1; ii <= sobol_bits; ++ii)
+      ret[ii] = uint32_t(1) << (sobol_bits - ii);
+    return ret;
+  }
+  const SobolDirection& direction = sobol_directions[dd - 1];
+  const size_t ss = direction.degree;
+  for (size_t ii = 1; ii <= std::min(ss, sobol_bits); ++ii)
+    ret[ii] = direction.initial[ii - 1] << (sobol_bits - ii);
+  for (size_t ii = ss + 1; ii <= sobol_bits; ++ii) {
+    ret[ii] = ret[ii - ss] ^ (ret[ii - ss] >> ss);
+    for (size_t kk = 1; kk < ss; ++kk)
+      if ((direction.coefficients >> (ss - 1 - kk)) & 1)
+        ret[ii] ^= ret[ii - kk];
+  }
+  return ret;
+} // ... sobol_direction_numbers(...)
+
+
+//! the number of entries of num serialized parameters of length dd, throws instead of overflowing
+static size_t num_entries(const size_t num, const size_t dd)
+{
+  if (dd > 0 && num > std::numeric_limits< size_t >::max() / dd)
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+               "too many parameters (" << num << ") of length " << dd << " requested!");
+  return num * dd;
+}
+
+
+} // namespace internal
+
+
+ParameterSampler::ParameterSampler(const ParameterType& tt, const double min, const double max)
+  : type_(tt)
+  , mins_(tt.layout()->dim(), min)
+  , maxs_(tt.layout()->dim(), max)
+{
+  if (!(min <= max))
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "min (" << min << ") must not be larger than max (" << max << ")!");
+}
+
+ParameterSampler::ParameterSampler(const ParameterType& tt, const std::map< std::string, RangeType >& ranges)
+  : type_(tt)
+  , mins_(tt.layout()->dim())
+  , maxs_(tt.layout()->dim())
+{
+  const auto& layout = *type_.layout();
+  for (const auto& key : layout.keys()) {
+    const auto result = ranges.find(key);
+    if (result == ranges.end())
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "missing the range of '" << key << "'!");
+    if (!(result->second.first <= result->second.second))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "the range of '" << key << "' is empty ([" << result->second.first << ", " << result->second.second
+                 << "])!");
+    const size_t offset = layout.offset(key);
+    for (size_t ii = 0; ii < layout.size(key); ++ii) {
+      mins_[offset + ii] = result->second.first;
+      maxs_[offset + ii] = result->second.second;
+    }
+  }
+} // ParameterSampler(...)
+
+ParameterSampler::ParameterSampler(const ParameterType& tt,
+                                   const std::vector< double >& mins,
+                                   const std::vector< double >& maxs)
+  : type_(tt)
+  , mins_(mins)
+  , maxs_(maxs)
+{
+  if (mins_.size() != dim() || maxs_.size() != dim())
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "mins (" << mins_.size() << ") and maxs (" << maxs_.size() << ") have to be of size " << dim() << "!");
+  for (size_t ii = 0; ii < dim(); ++ii)
+    if (!(mins_[ii] <= maxs_[ii]))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "mins[" << ii << "] (" << mins_[ii] << ") must not be larger than maxs[" << ii << "] (" << maxs_[ii]
+                 << ")!");
+} // ParameterSampler(...)
+
+const ParameterType& ParameterSampler::parameter_type() const
+{
+  return type_;
+}
+
+size_t ParameterSampler::dim() const
+{
+  return mins_.size();
+}
+
+std::vector< double > ParameterSampler::uniform(const size_t num_per_dim) const
+{
+  const size_t dd = dim();
+  if (num_per_dim == 0 || dd == 0)
+    return std::vector< double >();
+  size_t num = 1;
+  for (size_t ii = 0; ii < dd; ++ii) {
+    if (num > std::numeric_limits< size_t >::max() / num_per_dim)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "the grid of " << num_per_dim << "^" << dd << " points is too large!");
+    num *= num_per_dim;
+  }
+  std::vector< double > ret(internal::num_entries(num, dd));
+  std::vector< size_t > index(dd, 0);
+  for (size_t nn = 0; nn < num; ++nn) {
+    for (size_t ii = 0; ii < dd; ++ii)
+      ret[nn * dd + ii] = (num_per_dim == 1)
+                          ? 0.5 * (mins_[ii] + maxs_[ii])
+                          : mins_[ii] + (maxs_[ii] - mins_[ii]) * double(index[ii]) / double(num_per_dim - 1);
+    // increment the multi index, the last entry fastest
+    for (size_t ii = dd; ii > 0; --ii) {
+      if (++index[ii - 1] < num_per_dim)
+        break;
+      index[ii - 1] = 0;
+    }
+  }
+  return ret;
+} // ... uniform(...)
+
+std::vector< double > ParameterSampler::random(const size_t num, const size_t seed) const
+{
+  const size_t dd = dim();
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution< double > distribution(0., 1.);
+  std::vector< double > ret(internal::num_entries(num, dd));
+  for (size_t nn = 0; nn < num; ++nn)
+    for (size_t ii = 0; ii < dd; ++ii)
+      ret[nn * dd + ii] = mins_[ii] + (maxs_[ii] - mins_[ii]) * distribution(generator);
+  return ret;
+} // ... random(...)
+
+std::vector< double > ParameterSampler::latin_hypercube(const size_t num, const size_t seed) const
+{
+  const size_t dd = dim();
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution< double > distribution(0., 1.);
+  std::vector< double > ret(internal::num_entries(num, dd));
+  std::vector< size_t > strata(num);
+  for (size_t ii = 0; ii < dd; ++ii) {
+    std::iota(strata.begin(), strata.end(), size_t(0));
+    std::shuffle(strata.begin(), strata.end(), generator);
+    for (size_t nn = 0; nn < num; ++nn)
+      ret[nn * dd + ii] = mins_[ii]
+                          + (maxs_[ii] - mins_[ii]) * (double(strata[nn]) + distribution(generator)) / double(num);
+  }
+  return ret;
+} // ... latin_hypercube(...)
+
+std::vector< double > ParameterSampler::sobol(const size_t num, const size_t skip) const
+{
+  const size_t dd = dim();
+  if (dd > internal::sobol_max_dim)
+    DUNE_THROW(Stuff::Exceptions::requirements_not_met,
+               "the Sobol sequence is only available for up to " << internal::sobol_max_dim << " dimensions (dim() is "
+               << dd << ")!");
+  if (uint64_t(num) + uint64_t(skip) > (uint64_t(1) << internal::sobol_bits))
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+               "at most 2^" << internal::sobol_bits << " points of the Sobol sequence are available!");
+  std::vector< std::vector< uint32_t > > directions(dd);
+  for (size_t ii = 0; ii < dd; ++ii)
+    directions[ii] = internal::sobol_direction_numbers(ii);
+  // gray code construction: the point nn + 1 differs from point nn in the direction number of the lowest zero bit of nn
+  std::vector< uint32_t > point(dd, 0);
+  std::vector< double > ret(internal::num_entries(num, dd));
+  const double scale = 1. / double(uint64_t(1) << internal::sobol_bits);
+  for (size_t nn = 0; nn < skip + num; ++nn) {
+    if (nn >= skip)
+      for (size_t ii = 0; ii < dd; ++ii)
+        ret[(nn - skip) * dd + ii] = mins_[ii] + (maxs_[ii] - mins_[ii]) * double(point[ii]) * scale;
+    size_t bit = 1;
+    for (size_t value = nn; value & 1; value >>= 1)
+      ++bit;
+    if (bit <= internal::sobol_bits)
+      for (size_t ii = 0; ii < dd; ++ii)
+        point[ii] ^= directions[ii][bit];
+  }
+  return ret;
+} // ... sobol(...)
+
+std::vector< Parameter > ParameterSampler::parameters(const std::vector< double >& samples) const
+{
+  const auto flat = flat_parameters(samples);
+  std::vector< Parameter > ret;
+  ret.reserve(flat.size());
+  for (const auto& mu : flat)
+    ret.push_back(mu.parameter());
+  return ret;
+} // ... parameters(...)
+
+std::vector< FlatParameter > ParameterSampler::flat_parameters(const std::vector< double >& samples) const
+{
+  const size_t num = num_samples(samples);
+  const size_t dd = dim();
+  std::vector< FlatParameter > ret;
+  ret.reserve(num);
+  for (size_t nn = 0; nn < num; ++nn)
+    ret.emplace_back(type_.layout(), std::vector< double >(samples.begin() + nn * dd, samples.begin() + (nn + 1) * dd));
+  return ret;
+} // ... flat_parameters(...)
+
+size_t ParameterSampler::num_samples(const std::vector< double >& samples) const
+{
+  if (dim() == 0)
+    DUNE_THROW(Stuff::Exceptions::requirements_not_met, "the parameter type must not be empty!");
+  if (samples.size() % dim() != 0)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of samples (" << samples.size() << ") has to be a multiple of dim() (" << dim() << ")!");
+  return samples.size() / dim();
+}
+
+
+} // namespace Pymor
+} // namespace Dune
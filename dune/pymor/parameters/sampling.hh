@@ -0,0 +1,96 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_PARAMETERS_SAMPLING_HH
+#define DUNE_PYMOR_PARAMETERS_SAMPLING_HH
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "base.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Generates training sets of parameters of a given ParameterType within a box.
+ *
+ *        All samples are returned as one contiguous block of num * dim() values, parameter after parameter in the order
+ *        of Parameter::serialize(). The block can be passed directly to batch evaluations (e.g.,
+ *        ParameterFunctional::evaluate_batch()) or be converted to Parameters or FlatParameters at once.
+ */
+class ParameterSampler
+{
+public:
+  typedef std::pair< double, double > RangeType;
+
+  /**
+   * \brief All entries of all components range in [min, max].
+   */
+  ParameterSampler(const ParameterType& tt, const double min, const double max);
+
+  /**
+   * \brief The entries of each component key range in ranges[key], every key of tt has to be given.
+   */
+  ParameterSampler(const ParameterType& tt, const std::map< std::string, RangeType >& ranges);
+
+  /**
+   * \brief The entry ii of a serialized parameter ranges in [mins[ii], maxs[ii]].
+   */
+  ParameterSampler(const ParameterType& tt, const std::vector< double >& mins, const std::vector< double >& maxs);
+
+  const ParameterType& parameter_type() const;
+
+  //! the length of a serialized parameter
+  size_t dim() const;
+
+  /**
+   * \brief The tensor product grid of num_per_dim equidistant points (including the bounds) in each of the dim()
+   *        directions, the last entry varies fastest. A single point per direction is placed at the center.
+   */
+  std::vector< double > uniform(const size_t num_per_dim) const;
+
+  /**
+   * \brief num uniformly distributed random parameters, reproducible for a given seed.
+   */
+  std::vector< double > random(const size_t num, const size_t seed = 0) const;
+
+  /**
+   * \brief A Latin hypercube sample of num parameters: in each direction each of the num equally sized intervals
+   *        contains exactly one parameter.
+   */
+  std::vector< double > latin_hypercube(const size_t num, const size_t seed = 0) const;
+
+  /**
+   * \brief The first num points of the Sobol sequence (after skipping the first skip points), for dim() <= 21.
+   *
+   *        Uses the direction numbers of Joe and Kuo. The first point of the sequence is the lower corner of the box.
+   */
+  std::vector< double > sobol(const size_t num, const size_t skip = 0) const;
+
+  /**
+   * \brief Converts a block of samples to Parameters (e.g., for StationaryDiscretizationInterface::solve_many()).
+   */
+  std::vector< Parameter > parameters(const std::vector< double >& samples) const;
+
+  std::vector< FlatParameter > flat_parameters(const std::vector< double >& samples) const;
+
+private:
+  size_t num_samples(const std::vector< double >& samples) const;
+
+  const ParameterType type_;
+  std::vector< double > mins_;
+  std::vector< double > maxs_;
+}; // class ParameterSampler
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_PARAMETERS_SAMPLING_HH
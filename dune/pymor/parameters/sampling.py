@@ -0,0 +1,52 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_ParameterSampler(module, exceptions, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(CONFIG_H, dict))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    ParameterSampler = namespace.add_class('ParameterSampler')
+    ParameterSampler.add_copy_constructor()
+    ParameterSampler.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                      param('const double', 'min'),
+                                      param('const double', 'max')],
+                                     throw=exceptions)
+    ParameterSampler.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                      param('const std::vector< double >&', 'mins'),
+                                      param('const std::vector< double >&', 'maxs')],
+                                     throw=exceptions)
+    ParameterSampler.add_method('parameter_type',
+                                retval('const Dune::Pymor::ParameterType&'),
+                                [],
+                                is_const=True)
+    ParameterSampler.add_method('dim', retval('size_t'), [], is_const=True)
+    ParameterSampler.add_method('uniform',
+                                retval('std::vector< double >'),
+                                [param('const size_t', 'num_per_dim')],
+                                throw=exceptions,
+                                is_const=True)
+    for method in ('random', 'latin_hypercube'):
+        ParameterSampler.add_method(method,
+                                    retval('std::vector< double >'),
+                                    [param('const size_t', 'num'), param('const size_t', 'seed', default_value='0')],
+                                    throw=exceptions,
+                                    is_const=True)
+    ParameterSampler.add_method('sobol',
+                                retval('std::vector< double >'),
+                                [param('const size_t', 'num'), param('const size_t', 'skip', default_value='0')],
+                                throw=exceptions,
+                                is_const=True)
+    ParameterSampler.add_method('parameters',
+                                retval('std::vector< Dune::Pymor::Parameter >'),
+                                [param('const std::vector< double >&', 'samples')],
+                                throw=exceptions,
+                                is_const=True)
+    return module, ParameterSampler
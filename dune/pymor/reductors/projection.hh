@@ -0,0 +1,190 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_REDUCTORS_PROJECTION_HH
+#define DUNE_PYMOR_REDUCTORS_PROJECTION_HH
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container.hh>
+
+#include <dune/pymor/common/parallel.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/la/container/lincomb.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace Reductors {
+
+
+/**
+ * \brief Galerkin projection of affinely decomposed operators and functionals onto a reduced basis.
+ *
+ *        The basis V = [v_1, ..., v_N] is copied once into contiguous storage on construction. Each component A_q of an
+ *        operator is applied once to every basis vector, the reduced component V^T A_q V is then computed by a blocked
+ *        dense kernel, and all components f_q of a functional are reduced to V^T f_q in a single pass over the basis.
+ *        The reduced containers share the coefficients of the original ones.
+ */
+template< class VectorImp >
+class Projection
+{
+public:
+  typedef VectorImp                                      VectorType;
+  typedef typename VectorType::ScalarType                ScalarType;
+  typedef Stuff::LA::CommonDenseMatrix< ScalarType >     ReducedMatrixType;
+  typedef Stuff::LA::CommonDenseVector< ScalarType >     ReducedVectorType;
+
+  /**
+   * \param num_threads the number of threads the components of an operator are distributed to (see parallel_for()),
+   *        the containers have to support concurrent calls of mv() then
+   */
+  Projection(const std::vector< VectorType >& basis, const size_t num_threads = 1)
+    : basis_(basis)
+    , dim_(basis.empty() ? 0 : basis[0].size())
+    , num_threads_(num_threads)
+    , packed_basis_(basis.size() * dim_)
+  {
+    for (size_t ii = 0; ii < basis_.size(); ++ii) {
+      if (basis_[ii].size() != dim_)
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "all basis vectors have to be of the same size (" << basis_[ii].size() << " vs. " << dim_ << ")!");
+      LA::internal::pack(basis_[ii], packed_basis_.data() + ii * dim_);
+    }
+  }
+
+  //! the size N of the reduced basis
+  size_t size() const
+  {
+    return basis_.size();
+  }
+
+  //! the dimension of the high-dimensional space
+  size_t dim() const
+  {
+    return dim_;
+  }
+
+  /**
+   * \brief Returns the container of all reduced components V^T A_q V (and V^T A_aff V).
+   */
+  template< class MatrixType >
+  LA::AffinelyDecomposedContainer< ReducedMatrixType >
+  project_operator(const LA::AffinelyDecomposedConstContainer< MatrixType >& op) const
+  {
+    const bool affine = op.has_affine_part();
+    const size_t num_components = size_t(op.num_components());
+    std::vector< std::shared_ptr< const MatrixType > > matrices;
+    if (affine)
+      matrices.push_back(op.affine_part());
+    for (size_t qq = 0; qq < num_components; ++qq)
+      matrices.push_back(op.component(qq));
+    for (const auto& matrix : matrices)
+      if (matrix->rows() != dim_ || matrix->cols() != dim_)
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "the operator (" << matrix->rows() << "x" << matrix->cols()
+                   << ") does not match the basis (of dim " << dim_ << ")!");
+    const size_t N = basis_.size();
+    std::vector< std::shared_ptr< ReducedMatrixType > > reduced(matrices.size());
+    const size_t num_threads = std::max(size_t(1), std::min(num_threads_, matrices.size()));
+    // per thread: a temporary for A_q v_n and the packed columns of A_q V
+    // the temporaries are created separately, copies would share their storage
+    std::vector< VectorType > tmps;
+    for (size_t tt = 0; tt < num_threads; ++tt)
+      tmps.emplace_back(dim_);
+    std::vector< std::vector< ScalarType > > products(num_threads, std::vector< ScalarType >(N * dim_));
+    parallel_for(matrices.size(),
+                 [&](const size_t qq, const size_t thread) {
+                   VectorType& tmp = tmps[thread];
+                   std::vector< ScalarType >& product = products[thread];
+                   for (size_t nn = 0; nn < N; ++nn) {
+                     matrices[qq]->mv(basis_[nn], tmp);
+                     LA::internal::pack(tmp, product.data() + nn * dim_);
+                   }
+                   reduced[qq] = std::make_shared< ReducedMatrixType >(N, N);
+                   gemm(product, N, *reduced[qq]);
+                 },
+                 num_threads);
+    LA::AffinelyDecomposedContainer< ReducedMatrixType > ret;
+    size_t qq = 0;
+    if (affine)
+      ret.register_affine_part(reduced[qq++]);
+    for (size_t pp = 0; pp < num_components; ++pp, ++qq)
+      ret.register_component(reduced[qq], op.coefficient(pp));
+    return ret;
+  } // ... project_operator(...)
+
+  /**
+   * \brief Returns the container of all reduced components V^T f_q (and V^T f_aff).
+   */
+  LA::AffinelyDecomposedContainer< ReducedVectorType >
+  project_functional(const LA::AffinelyDecomposedConstContainer< VectorType >& functional) const
+  {
+    const bool affine = functional.has_affine_part();
+    const size_t num_components = size_t(functional.num_components());
+    std::vector< std::shared_ptr< const VectorType > > vectors;
+    if (affine)
+      vectors.push_back(functional.affine_part());
+    for (size_t qq = 0; qq < num_components; ++qq)
+      vectors.push_back(functional.component(qq));
+    const size_t M = vectors.size();
+    std::vector< ScalarType > packed(M * dim_);
+    for (size_t qq = 0; qq < M; ++qq) {
+      if (vectors[qq]->size() != dim_)
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "the functional (of dim " << vectors[qq]->size() << ") does not match the basis (of dim " << dim_
+                   << ")!");
+      LA::internal::pack(*vectors[qq], packed.data() + qq * dim_);
+    }
+    // one pass over the basis for all components: C = F^T V, row qq of C is V^T f_q
+    const size_t N = basis_.size();
+    std::vector< ScalarType > result(M * N);
+    LA::internal::gemm_tn(dim_, M, N, packed.data(), packed_basis_.data(), result.data());
+    LA::AffinelyDecomposedContainer< ReducedVectorType > ret;
+    size_t qq = 0;
+    if (affine)
+      ret.register_affine_part(reduced_vector(result.data() + N * qq++));
+    for (size_t pp = 0; pp < num_components; ++pp, ++qq)
+      ret.register_component(reduced_vector(result.data() + N * qq), functional.coefficient(pp));
+    return ret;
+  } // ... project_functional(...)
+
+private:
+  void gemm(const std::vector< ScalarType >& product, const size_t N, ReducedMatrixType& target) const
+  {
+    if (N == 0)
+      return;
+    std::vector< ScalarType > result(N * N);
+    LA::internal::gemm_tn(dim_, N, N, packed_basis_.data(), product.data(), result.data());
+    auto& backend = target.backend();
+    for (size_t ii = 0; ii < N; ++ii)
+      for (size_t jj = 0; jj < N; ++jj)
+        backend[ii][jj] = result[ii * N + jj];
+  } // ... gemm(...)
+
+  std::shared_ptr< ReducedVectorType > reduced_vector(const ScalarType* values) const
+  {
+    const size_t N = basis_.size();
+    auto ret = std::make_shared< ReducedVectorType >(N);
+    auto& backend = ret->backend();
+    for (size_t nn = 0; nn < N; ++nn)
+      backend[nn] = values[nn];
+    return ret;
+  }
+
+  const std::vector< VectorType > basis_;
+  const size_t dim_;
+  const size_t num_threads_;
+  std::vector< ScalarType > packed_basis_;
+}; // class Projection
+
+
+} // namespace Reductors
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_REDUCTORS_PROJECTION_HH
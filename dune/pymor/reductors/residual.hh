@@ -0,0 +1,321 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_REDUCTORS_RESIDUAL_HH
+#define DUNE_PYMOR_REDUCTORS_RESIDUAL_HH
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/string.hh>
+#include <dune/stuff/la/container.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/operators/base.hh>
+
+#include "projection.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace Reductors {
+
+
+/**
+ * \brief The dual norm of the residual f(mu) - A(mu) u_N of a reduced solution u_N = sum_n u_n v_n.
+ *
+ *        With the affine decompositions A(mu) = sum_q theta_q(mu) A_q and f(mu) = sum_p theta_p(mu) f_p, the residual
+ *        is a linear combination of the M = P + Q N vectors f_p and A_q v_n. Their Riesz representatives z_i with
+ *        respect to the product X (X z_i = b_i) and the Gram matrix G_ij = (z_i, z_j)_X = z_i^T b_j are computed once
+ *        on construction. The residual norm for mu is then sqrt(c^T G c), where c holds the coefficients of the linear
+ *        combination, which costs O(M^2) operations independently of the dimension of the high-dimensional space.
+ *        During construction, the vectors b_i are held packed and the z_i are computed in small blocks, such that only
+ *        about M + 16 high-dimensional vectors are held at a time.
+ *
+ *        apply() evaluates the coefficients c into members of this class, such that it does not allocate. An object
+ *        must thus not be applied from several threads at the same time, see also ReducedDense.
+ */
+template< class MatrixImp, class VectorImp >
+class ResidualNorm
+  : public Parametric
+{
+public:
+  typedef MatrixImp                                  MatrixType;
+  typedef VectorImp                                  VectorType;
+  typedef typename VectorType::ScalarType            ScalarType;
+  typedef Stuff::LA::CommonDenseVector< ScalarType > ReducedVectorType;
+
+  static std::string static_id() { return "pymor.reductors.residualnorm"; }
+
+  /**
+   * \param product the matrix of the inner product X, in the dual norm of which the residual is measured
+   * \param solver_type the type of linear solver used to invert the product, see Operators::MatrixBasedDefault
+   */
+  ResidualNorm(const LA::AffinelyDecomposedConstContainer< MatrixType >& op,
+               const LA::AffinelyDecomposedConstContainer< VectorType >& rhs,
+               const std::vector< VectorType >& basis,
+               const MatrixType& product,
+               const std::string solver_type
+                  = Operators::MatrixBasedDefault< MatrixType, VectorType >::invert_options()[0])
+    : basis_size_(basis.size())
+    , op_affine_(op.has_affine_part())
+    , rhs_affine_(rhs.has_affine_part())
+  {
+    const size_t dim = product.rows();
+    std::vector< std::shared_ptr< const VectorType > > vectors;
+    if (rhs_affine_)
+      vectors.push_back(rhs.affine_part());
+    for (DUNE_STUFF_SSIZE_T pp = 0; pp < rhs.num_components(); ++pp) {
+      vectors.push_back(rhs.component(pp));
+      rhs_coefficients_.push_back(rhs.coefficient(pp));
+      rhs_projections_.push_back(inherit_parameter_type(rhs.coefficient(pp)->parameter_type(),
+                                                        "rhs_coefficient_" + Stuff::Common::toString(pp)));
+    }
+    std::vector< std::shared_ptr< const MatrixType > > matrices;
+    if (op_affine_)
+      matrices.push_back(op.affine_part());
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < op.num_components(); ++qq) {
+      matrices.push_back(op.component(qq));
+      op_coefficients_.push_back(op.coefficient(qq));
+      op_projections_.push_back(inherit_parameter_type(op.coefficient(qq)->parameter_type(),
+                                                       "operator_coefficient_" + Stuff::Common::toString(qq)));
+    }
+    if (vectors.empty() || matrices.empty())
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met, "op and rhs must not be empty!");
+    // the terms b_i = [f_p, A_q v_n] are packed right away, only one of them is held as a VectorType at a time
+    const size_t num_terms = vectors.size() + matrices.size() * basis_size_;
+    std::vector< ScalarType > packed_terms(num_terms * dim);
+    size_t tt = 0;
+    for (const auto& vector : vectors)
+      pack_term(*vector, dim, packed_terms.data() + (tt++) * dim);
+    VectorType term(dim);
+    for (const auto& matrix : matrices)
+      for (const auto& vector : basis) {
+        matrix->mv(vector, term);
+        pack_term(term, dim, packed_terms.data() + (tt++) * dim);
+      }
+    // the Riesz representatives z_i are computed block-wise, each block contributes the rows G_i. = z_i^T B
+    static const size_t block_size = 16;
+    const auto inverse = Operators::MatrixBasedDefault< MatrixType, VectorType >(product).invert(solver_type);
+    std::vector< ScalarType > packed_representatives(std::min(block_size, num_terms) * dim);
+    VectorType representative(dim);
+    gram_.resize(num_terms * num_terms);
+    for (size_t begin = 0; begin < num_terms; begin += block_size) {
+      const size_t block = std::min(block_size, num_terms - begin);
+      for (size_t kk = 0; kk < block; ++kk) {
+        LA::internal::unpack(packed_terms.data() + (begin + kk) * dim, term);
+        inverse.apply(term, representative);
+        LA::internal::pack(representative, packed_representatives.data() + kk * dim);
+      }
+      LA::internal::gemm_tn(dim, block, num_terms, packed_representatives.data(), packed_terms.data(),
+                            gram_.data() + begin * num_terms);
+    }
+    // symmetrize to remove the error of the linear solver
+    for (size_t ii = 0; ii < num_terms; ++ii)
+      for (size_t jj = ii + 1; jj < num_terms; ++jj)
+        gram_[ii * num_terms + jj] = gram_[jj * num_terms + ii]
+            = 0.5 * (gram_[ii * num_terms + jj] + gram_[jj * num_terms + ii]);
+    size_t scratch_size = 0;
+    for (const auto& coefficient : op_coefficients_)
+      scratch_size = std::max(scratch_size, coefficient->parameter_type().layout()->dim());
+    for (const auto& coefficient : rhs_coefficients_)
+      scratch_size = std::max(scratch_size, coefficient->parameter_type().layout()->dim());
+    scratch_.resize(scratch_size);
+    coefficients_.resize(num_terms);
+    op_thetas_.resize(matrices.size());
+  } // ResidualNorm(...)
+
+  //! the number M of vectors the residual is combined of
+  size_t num_terms() const
+  {
+    return coefficients_.size();
+  }
+
+  /**
+   * \brief The Gram matrix of the Riesz representatives (row-major, num_terms() x num_terms()).
+   */
+  const std::vector< ScalarType >& gram() const
+  {
+    return gram_;
+  }
+
+  /**
+   * \brief Computes the residual norm for the serialized parameter mu (of parameter_type()) and the coefficients u_N
+   *        of the reduced solution, without allocating any memory.
+   */
+  ScalarType apply(const double* mu, const size_t mu_size, const ScalarType* u_N) const
+  {
+    if (mu_size != parameter_type().layout()->dim())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "mu has " << mu_size << " entries, the parameter_type of this requires "
+                 << parameter_type().layout()->dim() << "!");
+    // c = [theta_p(mu), -theta_q(mu) u_n]
+    size_t ii = 0;
+    if (rhs_affine_)
+      coefficients_[ii++] = 1.;
+    for (size_t pp = 0; pp < rhs_coefficients_.size(); ++pp)
+      coefficients_[ii++] = evaluate(*rhs_coefficients_[pp], rhs_projections_[pp], mu);
+    size_t qq = 0;
+    if (op_affine_)
+      op_thetas_[qq++] = 1.;
+    for (size_t kk = 0; kk < op_coefficients_.size(); ++kk)
+      op_thetas_[qq++] = evaluate(*op_coefficients_[kk], op_projections_[kk], mu);
+    for (qq = 0; qq < op_thetas_.size(); ++qq)
+      for (size_t nn = 0; nn < basis_size_; ++nn)
+        coefficients_[ii++] = -op_thetas_[qq] * u_N[nn];
+    // c^T G c
+    const size_t num_terms = coefficients_.size();
+    ScalarType ret = 0;
+    for (ii = 0; ii < num_terms; ++ii) {
+      const ScalarType* row = gram_.data() + ii * num_terms;
+      ScalarType sum = 0;
+      for (size_t jj = 0; jj < num_terms; ++jj)
+        sum += row[jj] * coefficients_[jj];
+      ret += coefficients_[ii] * sum;
+    }
+    // the cancellation in c^T G c may render small residuals slightly negative
+    return std::sqrt(std::max(ret, ScalarType(0)));
+  } // ... apply(...)
+
+  ScalarType apply(const FlatParameter& mu, const ReducedVectorType& u_N) const
+  {
+    if (!mu.has_type(parameter_type()))
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.parameter().type() << ") does not match the parameter_type of this ("
+                 << parameter_type() << ")!");
+    check_size(u_N);
+    return apply(mu.data(), mu.size(), &(u_N.backend()[0]));
+  }
+
+  ScalarType apply(const Parameter& mu, const ReducedVectorType& u_N) const
+  {
+    if (mu.type() != parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                 << parameter_type() << ")!");
+    check_size(u_N);
+    const auto serialized_mu = mu.serialize();
+    return apply(serialized_mu.data(), serialized_mu.size(), &(u_N.backend()[0]));
+  }
+
+private:
+  static void pack_term(const VectorType& term, const size_t dim, ScalarType* target)
+  {
+    if (term.size() != dim)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of all vectors (" << term.size() << ") has to match the product (" << dim << ")!");
+    LA::internal::pack(term, target);
+  }
+
+  void check_size(const ReducedVectorType& u_N) const
+  {
+    if (u_N.size() != basis_size_ || basis_size_ == 0)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of u_N (" << u_N.size() << ") does not match the size of the basis (" << basis_size_
+                 << ")!");
+  }
+
+  double evaluate(const ParameterFunctional& coefficient, const size_t projection_index, const double* mu) const
+  {
+    const auto& projection = parameter_projection(projection_index);
+    return coefficient.evaluate(projection.map(mu, scratch_.data()), projection.dim());
+  }
+
+  size_t basis_size_;
+  bool op_affine_;
+  bool rhs_affine_;
+  std::vector< std::shared_ptr< const ParameterFunctional > > op_coefficients_;
+  std::vector< std::shared_ptr< const ParameterFunctional > > rhs_coefficients_;
+  std::vector< size_t > op_projections_;
+  std::vector< size_t > rhs_projections_;
+  std::vector< ScalarType > gram_;
+  mutable std::vector< double > scratch_;
+  mutable std::vector< double > op_thetas_;
+  mutable std::vector< ScalarType > coefficients_;
+}; // class ResidualNorm
+
+
+/**
+ * \brief A lower bound of the coercivity constant by the min-theta approach.
+ *
+ *        For an affinely decomposable function (e.g., the diffusion) with positive coefficients,
+ *        alpha(mu) >= alpha(mu_bar) * function.alpha(mu, mu_bar), where alpha(mu_bar) is the coercivity constant for
+ *        the reference parameter mu_bar (see AffinelyDecomposableFunctionInterface::alpha()).
+ */
+template< class FunctionType >
+class MinThetaCoercivityBound
+{
+public:
+  MinThetaCoercivityBound(const std::shared_ptr< const FunctionType > function,
+                          const Parameter mu_bar,
+                          const double alpha_mu_bar)
+    : function_(function)
+    , mu_bar_(mu_bar)
+    , alpha_mu_bar_(alpha_mu_bar)
+  {
+    if (!(alpha_mu_bar_ > 0.))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "alpha_mu_bar has to be positive (is " << alpha_mu_bar_ << ")!");
+  }
+
+  /**
+   * \param mu may contain more keys than the parameter_type of the function, these are ignored
+   */
+  double lower_bound(const Parameter& mu) const
+  {
+    return alpha_mu_bar_ * function_->alpha(restrict(mu), mu_bar_);
+  }
+
+  //! the corresponding upper bound of the continuity constant, relative to the one for mu_bar
+  double gamma(const Parameter& mu) const
+  {
+    return function_->gamma(restrict(mu), mu_bar_);
+  }
+
+private:
+  Parameter restrict(const Parameter& mu) const
+  {
+    const ParameterType& type = function_->parameter_type();
+    if (mu.type() == type)
+      return mu;
+    Parameter ret;
+    for (const auto& key : type.keys())
+      ret.set(key, mu.get(key));
+    return ret;
+  } // ... restrict(...)
+
+  const std::shared_ptr< const FunctionType > function_;
+  const Parameter mu_bar_;
+  const double alpha_mu_bar_;
+}; // class MinThetaCoercivityBound
+
+
+/**
+ * \brief The a posteriori error estimate ||u(mu) - u_N(mu)||_X <= ||f(mu) - A(mu) u_N||_X' / alpha_LB(mu).
+ */
+template< class MatrixType, class VectorType, class CoercivityBoundType >
+double estimate_error(const ResidualNorm< MatrixType, VectorType >& residual_norm,
+                      const CoercivityBoundType& coercivity,
+                      const Parameter& mu,
+                      const typename ResidualNorm< MatrixType, VectorType >::ReducedVectorType& u_N)
+{
+  const double lower_bound = coercivity.lower_bound(mu);
+  if (!(lower_bound > 0.))
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "the lower bound of the coercivity constant has to be positive (is " << lower_bound << ")!");
+  return residual_norm.apply(mu, u_N) / lower_bound;
+}
+
+
+} // namespace Reductors
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_REDUCTORS_RESIDUAL_HH
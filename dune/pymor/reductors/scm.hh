@@ -0,0 +1,629 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_REDUCTORS_SCM_HH
+#define DUNE_PYMOR_REDUCTORS_SCM_HH
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/parallel.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/operators/base.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace Reductors {
+namespace internal {
+
+
+/**
+ * \brief A dense tableau for the simplex method, the last row holds the reduced costs and the negative objective.
+ */
+template< class ScalarType >
+class SimplexTableau
+{
+public:
+  SimplexTableau(const size_t rows, const size_t cols)
+    : rows_(rows)
+    , cols_(cols)
+    , values_((rows + 1) * (cols + 1), ScalarType(0))
+    , basis_(rows, 0)
+  {}
+
+  ScalarType& operator()(const size_t ii, const size_t jj) { return values_[ii * (cols_ + 1) + jj]; }
+
+  ScalarType operator()(const size_t ii, const size_t jj) const { return values_[ii * (cols_ + 1) + jj]; }
+
+  ScalarType& rhs(const size_t ii) { return (*this)(ii, cols_); }
+
+  std::vector< size_t >& basis() { return basis_; }
+
+  void pivot(const size_t row, const size_t col)
+  {
+    const ScalarType inverse_pivot = ScalarType(1) / (*this)(row, col);
+    for (size_t jj = 0; jj <= cols_; ++jj)
+      (*this)(row, jj) *= inverse_pivot;
+    for (size_t ii = 0; ii <= rows_; ++ii) {
+      if (ii == row)
+        continue;
+      const ScalarType factor = (*this)(ii, col);
+      if (factor == ScalarType(0))
+        continue;
+      for (size_t jj = 0; jj <= cols_; ++jj)
+        (*this)(ii, jj) -= factor * (*this)(row, jj);
+    }
+    basis_[row] = col;
+  } // ... pivot(...)
+
+  /**
+   * \brief Runs the simplex method on the columns [0, num_allowed), using Bland's rule to avoid cycling.
+   * \return false, if the problem is unbounded
+   */
+  bool optimize(const size_t num_allowed, const ScalarType tolerance)
+  {
+    while (true) {
+      size_t entering = num_allowed;
+      for (size_t jj = 0; jj < num_allowed; ++jj)
+        if ((*this)(rows_, jj) < -tolerance) {
+          entering = jj;
+          break;
+        }
+      if (entering == num_allowed)
+        return true;
+      size_t leaving = rows_;
+      ScalarType min_ratio = std::numeric_limits< ScalarType >::max();
+      for (size_t ii = 0; ii < rows_; ++ii) {
+        const ScalarType value = (*this)(ii, entering);
+        if (value > tolerance) {
+          const ScalarType ratio = rhs(ii) / value;
+          if (ratio < min_ratio - tolerance
+              || (ratio < min_ratio + tolerance && leaving < rows_ && basis_[ii] < basis_[leaving])) {
+            min_ratio = std::min(min_ratio, ratio);
+            leaving = ii;
+          }
+        }
+      }
+      if (leaving == rows_)
+        return false;
+      pivot(leaving, entering);
+    }
+  } // ... optimize(...)
+
+private:
+  const size_t rows_;
+  const size_t cols_;
+  std::vector< ScalarType > values_;
+  std::vector< size_t > basis_;
+}; // class SimplexTableau
+
+
+/**
+ * \brief Solves min c^T x subject to A x <= b and x >= 0 by the two-phase simplex method.
+ *
+ *        A is row-major (num_constraints x c.size()), b may have entries of any sign.
+ * \return the optimal value, x is set to the minimizer
+ */
+template< class ScalarType >
+ScalarType simplex_minimize(const std::vector< ScalarType >& c,
+                            const std::vector< ScalarType >& A,
+                            const std::vector< ScalarType >& b,
+                            std::vector< ScalarType >& x,
+                            const ScalarType tolerance = 1e-12)
+{
+  const size_t nn = c.size();
+  const size_t mm = b.size();
+  if (A.size() != nn * mm)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "A has " << A.size() << " entries, should have " << mm << "x" << nn << "!");
+  // columns: x, one slack per row, one artificial per row with negative b
+  size_t num_artificials = 0;
+  for (const auto& value : b)
+    if (value < 0)
+      ++num_artificials;
+  const size_t cols = nn + mm + num_artificials;
+  SimplexTableau< ScalarType > tableau(mm, cols);
+  size_t artificial = nn + mm;
+  ScalarType scale = 1;
+  for (size_t ii = 0; ii < mm; ++ii) {
+    scale = std::max(scale, std::abs(b[ii]));
+    const ScalarType sign = (b[ii] < 0) ? -1 : 1;
+    for (size_t jj = 0; jj < nn; ++jj)
+      tableau(ii, jj) = sign * A[ii * nn + jj];
+    tableau(ii, nn + ii) = sign;
+    tableau.rhs(ii) = sign * b[ii];
+    if (b[ii] < 0) {
+      tableau(ii, artificial) = 1;
+      tableau.basis()[ii] = artificial++;
+      // phase one minimizes the sum of the artificials
+      for (size_t jj = 0; jj <= cols; ++jj)
+        if (jj < nn + mm || jj == cols)
+          tableau(mm, jj) -= tableau(ii, jj);
+    } else
+      tableau.basis()[ii] = nn + ii;
+  }
+  if (num_artificials > 0) {
+    tableau.optimize(cols, tolerance);
+    if (-tableau(mm, cols) > tolerance * scale)
+      DUNE_THROW(Stuff::Exceptions::internal_error, "the linear program is infeasible!");
+    // drive the remaining (zero) artificials out of the basis, if possible
+    for (size_t ii = 0; ii < mm; ++ii)
+      if (tableau.basis()[ii] >= nn + mm)
+        for (size_t jj = 0; jj < nn + mm; ++jj)
+          if (std::abs(tableau(ii, jj)) > tolerance) {
+            tableau.pivot(ii, jj);
+            break;
+          }
+  }
+  // phase two
+  for (size_t jj = 0; jj <= cols; ++jj)
+    tableau(mm, jj) = (jj < nn) ? c[jj] : ScalarType(0);
+  for (size_t ii = 0; ii < mm; ++ii) {
+    const size_t basic = tableau.basis()[ii];
+    if (basic < nn && c[basic] != ScalarType(0))
+      for (size_t jj = 0; jj <= cols; ++jj)
+        tableau(mm, jj) -= c[basic] * tableau(ii, jj);
+  }
+  if (!tableau.optimize(nn + mm, tolerance))
+    DUNE_THROW(Stuff::Exceptions::internal_error, "the linear program is unbounded!");
+  x.assign(nn, ScalarType(0));
+  for (size_t ii = 0; ii < mm; ++ii)
+    if (tableau.basis()[ii] < nn)
+      x[tableau.basis()[ii]] = tableau.rhs(ii);
+  return -tableau(mm, cols);
+} // ... simplex_minimize(...)
+
+
+/**
+ * \brief Computes all eigenpairs of a small symmetric matrix by the cyclic Jacobi method.
+ * \param matrix       row-major (size x size), overwritten
+ * \param eigenvalues  set to the eigenvalues
+ * \param eigenvectors set to the row-major (size x size) matrix, the column jj of which is the (normalized)
+ *                     eigenvector of eigenvalues[jj]
+ */
+template< class ScalarType >
+void symmetric_eigenproblem(std::vector< ScalarType >& matrix,
+                            const size_t size,
+                            std::vector< ScalarType >& eigenvalues,
+                            std::vector< ScalarType >& eigenvectors)
+{
+  if (matrix.size() != size * size)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "matrix has " << matrix.size() << " entries, should have " << size << "x" << size << "!");
+  const auto entry = [&](const size_t ii, const size_t jj) -> ScalarType& { return matrix[ii * size + jj]; };
+  eigenvectors.assign(size * size, ScalarType(0));
+  for (size_t ii = 0; ii < size; ++ii)
+    eigenvectors[ii * size + ii] = ScalarType(1);
+  ScalarType norm_squared(0);
+  for (const auto& value : matrix)
+    norm_squared += value * value;
+  const ScalarType epsilon = std::numeric_limits< ScalarType >::epsilon();
+  for (size_t sweep = 0; sweep < 100; ++sweep) {
+    ScalarType off_diagonal(0);
+    for (size_t pp = 0; pp < size; ++pp)
+      for (size_t qq = pp + 1; qq < size; ++qq)
+        off_diagonal += entry(pp, qq) * entry(pp, qq);
+    if (off_diagonal <= epsilon * epsilon * norm_squared)
+      break;
+    for (size_t pp = 0; pp < size; ++pp)
+      for (size_t qq = pp + 1; qq < size; ++qq) {
+        if (entry(pp, qq) == ScalarType(0))
+          continue;
+        // the rotation by (c, s) annihilates the entry (pp, qq)
+        const ScalarType theta = (entry(qq, qq) - entry(pp, pp)) / (2 * entry(pp, qq));
+        const ScalarType tt = ((theta < 0) ? -1 : 1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+        const ScalarType cc = 1 / std::sqrt(tt * tt + 1);
+        const ScalarType ss = tt * cc;
+        for (size_t kk = 0; kk < size; ++kk) {
+          const ScalarType kp = entry(kk, pp);
+          const ScalarType kq = entry(kk, qq);
+          entry(kk, pp) = cc * kp - ss * kq;
+          entry(kk, qq) = ss * kp + cc * kq;
+        }
+        for (size_t kk = 0; kk < size; ++kk) {
+          const ScalarType pk = entry(pp, kk);
+          const ScalarType qk = entry(qq, kk);
+          entry(pp, kk) = cc * pk - ss * qk;
+          entry(qq, kk) = ss * pk + cc * qk;
+        }
+        for (size_t kk = 0; kk < size; ++kk) {
+          const ScalarType kp = eigenvectors[kk * size + pp];
+          const ScalarType kq = eigenvectors[kk * size + qq];
+          eigenvectors[kk * size + pp] = cc * kp - ss * kq;
+          eigenvectors[kk * size + qq] = ss * kp + cc * kq;
+        }
+      }
+  }
+  eigenvalues.resize(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    eigenvalues[ii] = entry(ii, ii);
+} // ... symmetric_eigenproblem(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief The successive constraint method for a rigorous lower bound of the coercivity constant
+ *        alpha(mu) = min_v (v, A(mu) v) / (v, v)_X of a symmetric affinely decomposed operator
+ *        A(mu) = sum_q theta_q(mu) A_q.
+ *
+ *        Offline, the extreme eigenvalues sigma_q^- <= (v, A_q v) / (v, v)_X <= sigma_q^+ of each component are
+ *        computed by the Lanczos method for X^-1 A_q, as well as alpha(mu_k) and the Rayleigh quotients
+ *        y_k = ((v, A_q v) / (v, v)_X)_q of the minimizing eigenvector v for each parameter mu_k of the training set
+ *        (by the Lanczos method for A(mu_k)^-1 X, using the factorization of A(mu_k)). All eigenproblems are
+ *        independent and are distributed to several threads. The Lanczos method keeps its basis X-orthogonal and is
+ *        restarted with the current extreme Ritz vectors every 50 steps. It stops once the residuals of these are below
+ *        the tolerance, which does not require the eigenvalues to be well separated. Each computed eigenvalue is
+ *        widened by the dual norm of the residual of its eigenvector (sigma_q^- and alpha(mu_k) are lowered,
+ *        sigma_q^+ is raised).
+ *
+ *        Online, the lower bound is the solution of the linear program min_y sum_q theta_q(mu) y_q subject to
+ *        sigma^- <= y <= sigma^+ and sum_q theta_q(mu_k) y_q >= alpha(mu_k) for the training parameters closest to mu,
+ *        and the upper bound is min_k sum_q theta_q(mu) y_k,q. The Ritz values never exceed the extreme eigenvalues
+ *        (they lie in between), and the residual bound encloses the eigenvalue they approximate. The bounds are thus
+ *        rigorous, unless the start vector is (numerically) X-orthogonal to an extreme eigenvector, such that a Ritz
+ *        value converges to an inner eigenvalue instead. The eigensolvers throw a MathError if they do not converge
+ *        within max_iterations. The affine part of A (if any) is treated as a component with coefficient 1.
+ */
+template< class MatrixImp, class VectorImp >
+class SuccessiveConstraints
+{
+public:
+  typedef MatrixImp                       MatrixType;
+  typedef VectorImp                       VectorType;
+  typedef typename VectorType::ScalarType ScalarType;
+
+  static std::string static_id() { return "pymor.reductors.successiveconstraints"; }
+
+  /**
+   * \param product       the matrix of the inner product X
+   * \param training_set  the parameters mu_k the coercivity constant is computed for
+   * \param num_neighbors the number of training parameters closest to mu (in the euclidean distance of the serialized
+   *                      parameters) used as constraints in lower_bound(), 0 for all
+   * \param tolerance     the tolerance of the residuals of the eigensolvers, relative to the largest Ritz value in
+   *                      magnitude (the computed eigenvalues are widened by the residuals)
+   * \param max_iterations the maximal number of operator applications of each eigensolver
+   * \param num_threads   see parallel_for(), the containers have to support concurrent calls of mv() then
+   */
+  SuccessiveConstraints(const LA::AffinelyDecomposedConstContainer< MatrixType >& op,
+                        const MatrixType& product,
+                        const std::vector< Parameter >& training_set,
+                        const size_t num_neighbors = 0,
+                        const double tolerance = 1e-10,
+                        const size_t max_iterations = 10000,
+                        const size_t num_threads = 1,
+                        const std::string solver_type
+                           = Operators::MatrixBasedDefault< MatrixType, VectorType >::invert_options()[0])
+    : op_(op)
+    , product_(std::make_shared< MatrixType >(product))
+    , num_neighbors_(num_neighbors)
+    , tolerance_(tolerance)
+    , max_iterations_(max_iterations)
+    , solver_type_(solver_type)
+  {
+    if (training_set.empty())
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "training_set must not be empty!");
+    if (op_.has_affine_part())
+      components_.push_back(op_.affine_part());
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < op_.num_components(); ++qq)
+      components_.push_back(op_.component(qq));
+    if (components_.empty())
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met, "op must not be empty!");
+    const size_t num_components = components_.size();
+    const auto product_inverse
+        = Operators::MatrixBasedDefault< MatrixType, VectorType >(product_).invert(solver_type_);
+    sigma_min_.resize(num_components);
+    sigma_max_.resize(num_components);
+    training_parameters_.reserve(training_set.size());
+    for (const auto& mu : training_set)
+      training_parameters_.emplace_back(mu);
+    alphas_.resize(training_set.size());
+    training_thetas_.resize(training_set.size());
+    rayleigh_quotients_.resize(training_set.size());
+    // the bounding box (two eigenproblems per component) and the training set
+    parallel_for(num_components + training_set.size(),
+                 [&](const size_t ii, const size_t /*thread*/) {
+                   if (ii < num_components)
+                     compute_bounding_box(ii, product_inverse);
+                   else
+                     compute_alpha(ii - num_components, product_inverse);
+                 },
+                 num_threads);
+  } // SuccessiveConstraints(...)
+
+  //! the lower bounds sigma_q^- of the components (the affine part first, if any)
+  const std::vector< double >& sigma_min() const
+  {
+    return sigma_min_;
+  }
+
+  const std::vector< double >& sigma_max() const
+  {
+    return sigma_max_;
+  }
+
+  //! the coercivity constants alpha(mu_k) of the training set
+  const std::vector< double >& alphas() const
+  {
+    return alphas_;
+  }
+
+  double lower_bound(const Parameter& mu) const
+  {
+    const FlatParameter flat_mu(mu);
+    const auto thetas = evaluate(flat_mu);
+    const size_t num_components = thetas.size();
+    const auto constraints = neighbors(flat_mu);
+    // substitute y = sigma^- + s, 0 <= s <= sigma^+ - sigma^-
+    std::vector< double > A((constraints.size() + num_components) * num_components, 0.);
+    std::vector< double > b(constraints.size() + num_components, 0.);
+    double offset = 0.;
+    for (size_t qq = 0; qq < num_components; ++qq)
+      offset += thetas[qq] * sigma_min_[qq];
+    for (size_t ii = 0; ii < constraints.size(); ++ii) {
+      const auto& training_thetas = training_thetas_[constraints[ii]];
+      // sum_q theta_q(mu_k) s_q >= alpha(mu_k) - sum_q theta_q(mu_k) sigma_q^-
+      b[ii] = -alphas_[constraints[ii]];
+      for (size_t qq = 0; qq < num_components; ++qq) {
+        A[ii * num_components + qq] = -training_thetas[qq];
+        b[ii] += training_thetas[qq] * sigma_min_[qq];
+      }
+    }
+    for (size_t qq = 0; qq < num_components; ++qq) {
+      A[(constraints.size() + qq) * num_components + qq] = 1.;
+      b[constraints.size() + qq] = sigma_max_[qq] - sigma_min_[qq];
+    }
+    std::vector< double > ss;
+    return offset + internal::simplex_minimize(thetas, A, b, ss);
+  } // ... lower_bound(...)
+
+  double upper_bound(const Parameter& mu) const
+  {
+    const auto thetas = evaluate(FlatParameter(mu));
+    double ret = std::numeric_limits< double >::max();
+    for (const auto& quotients : rayleigh_quotients_) {
+      double value = 0.;
+      for (size_t qq = 0; qq < thetas.size(); ++qq)
+        value += thetas[qq] * quotients[qq];
+      ret = std::min(ret, value);
+    }
+    return ret;
+  } // ... upper_bound(...)
+
+private:
+  typedef typename Operators::MatrixBasedDefault< MatrixType, VectorType >::InverseType InverseType;
+
+  std::vector< double > evaluate(const FlatParameter& mu) const
+  {
+    std::vector< double > thetas;
+    op_.evaluate_coefficients(mu, thetas);
+    if (op_.has_affine_part())
+      thetas.insert(thetas.begin(), 1.);
+    return thetas;
+  }
+
+  std::vector< size_t > neighbors(const FlatParameter& mu) const
+  {
+    std::vector< std::pair< double, size_t > > distances(training_parameters_.size());
+    for (size_t kk = 0; kk < training_parameters_.size(); ++kk) {
+      double distance = 0.;
+      for (size_t ii = 0; ii < mu.size(); ++ii)
+        distance += std::pow(mu.data()[ii] - training_parameters_[kk].data()[ii], 2);
+      distances[kk] = std::make_pair(distance, kk);
+    }
+    const size_t num = (num_neighbors_ == 0) ? distances.size() : std::min(num_neighbors_, distances.size());
+    std::partial_sort(distances.begin(), distances.begin() + num, distances.end());
+    std::vector< size_t > ret(num);
+    for (size_t kk = 0; kk < num; ++kk)
+      ret[kk] = distances[kk].second;
+    return ret;
+  } // ... neighbors(...)
+
+  VectorType initial_vector() const
+  {
+    const size_t dim = product_->rows();
+    VectorType ret(dim);
+    for (size_t ii = 0; ii < dim; ++ii)
+      ret.set_entry(ii, 1. + 0.5 * std::sin(double(ii + 1)));
+    return ret;
+  }
+
+  /**
+   * \brief Computes the Ritz vectors of the extreme eigenvalues of an operator B, which is symmetric w.r.t. X, by the
+   *        restarted Lanczos method with full reorthogonalization.
+   *
+   *        Returns once the residual ||B y - theta y||_X of the X-normalized Ritz vector y of the largest (and, if both
+   *        is true, of the smallest) Ritz value theta is below tolerance times the largest Ritz value in magnitude.
+   * \param apply_operator computes B v
+   */
+  template< class ApplyType >
+  void lanczos(const ApplyType& apply_operator, const bool both, VectorType& largest, VectorType& smallest) const
+  {
+    const size_t dim = product_->rows();
+    const size_t krylov_dim = std::min(dim, size_t(50));
+    std::vector< VectorType > basis;
+    basis.reserve(krylov_dim);
+    std::vector< double > diagonal;
+    std::vector< double > off_diagonal;
+    std::vector< double > tridiagonal;
+    std::vector< double > ritz_values;
+    std::vector< double > ritz_vectors;
+    VectorType ww(dim);
+    VectorType product_ww(dim);
+    VectorType start = initial_vector();
+    size_t num_applications = 0;
+    double estimate = 0.;
+    while (true) {
+      basis.clear();
+      diagonal.clear();
+      off_diagonal.clear();
+      product_->mv(start, product_ww);
+      start.scal(1. / std::sqrt(start.dot(product_ww)));
+      basis.push_back(start.copy());
+      while (true) {
+        if (num_applications == max_iterations_)
+          DUNE_THROW(MathError,
+                     "the Lanczos method did not converge in " << max_iterations_ << " iterations (last estimate: "
+                     << estimate << ")!");
+        apply_operator(basis.back(), ww);
+        ++num_applications;
+        // orthogonalize against the whole basis (twice, the Lanczos vectors lose their orthogonality otherwise)
+        double alpha = 0.;
+        for (size_t pass = 0; pass < 2; ++pass) {
+          product_->mv(ww, product_ww);
+          for (size_t jj = 0; jj < basis.size(); ++jj) {
+            const double coefficient = basis[jj].dot(product_ww);
+            ww.axpy(-coefficient, basis[jj]);
+            if (jj + 1 == basis.size())
+              alpha += coefficient;
+          }
+        }
+        diagonal.push_back(alpha);
+        product_->mv(ww, product_ww);
+        const double beta = std::sqrt(std::max(ww.dot(product_ww), 0.));
+        // the Ritz pairs, the residual of the Ritz vector basis * s is beta * |s_m|
+        const size_t mm = basis.size();
+        tridiagonal.assign(mm * mm, 0.);
+        for (size_t ii = 0; ii < mm; ++ii) {
+          tridiagonal[ii * mm + ii] = diagonal[ii];
+          if (ii + 1 < mm)
+            tridiagonal[ii * mm + ii + 1] = tridiagonal[(ii + 1) * mm + ii] = off_diagonal[ii];
+        }
+        internal::symmetric_eigenproblem(tridiagonal, mm, ritz_values, ritz_vectors);
+        const size_t max_index = std::max_element(ritz_values.begin(), ritz_values.end()) - ritz_values.begin();
+        const size_t min_index = std::min_element(ritz_values.begin(), ritz_values.end()) - ritz_values.begin();
+        estimate = ritz_values[max_index];
+        const double scale = std::max(std::abs(ritz_values[max_index]), std::abs(ritz_values[min_index]));
+        const auto converged = [&](const size_t index) {
+          return beta * std::abs(ritz_vectors[(mm - 1) * mm + index]) <= tolerance_ * scale;
+        };
+        // the basis spans an invariant subspace if beta vanishes
+        const bool done = (converged(max_index) && (!both || converged(min_index)))
+                          || beta <= std::numeric_limits< double >::epsilon() * scale || mm == dim;
+        if (done || mm == krylov_dim) {
+          largest = VectorType(dim);
+          smallest = VectorType(dim);
+          for (size_t jj = 0; jj < mm; ++jj) {
+            largest.axpy(ritz_vectors[jj * mm + max_index], basis[jj]);
+            smallest.axpy(ritz_vectors[jj * mm + min_index], basis[jj]);
+          }
+          if (done)
+            return;
+          start = largest.copy();
+          if (both)
+            start.axpy(1., smallest);
+          break;
+        }
+        off_diagonal.push_back(beta);
+        ww.scal(1. / beta);
+        basis.push_back(ww.copy());
+      }
+    }
+  } // ... lanczos(...)
+
+  /**
+   * \brief Returns the Rayleigh quotient rho = (v, A v) / (v, v)_X and sets error to the residual norm
+   *        ||A v - rho X v||_X' / ||v||_X.
+   *
+   *        Since A is symmetric, there is an eigenvalue of A v = lambda X v in [rho - error, rho + error].
+   */
+  double rayleigh_quotient(const MatrixType& matrix,
+                           const InverseType& product_inverse,
+                           const VectorType& vv,
+                           double& error) const
+  {
+    VectorType product_vv(vv.size());
+    VectorType residual(vv.size());
+    VectorType riesz_residual(vv.size());
+    product_->mv(vv, product_vv);
+    const double norm_squared = vv.dot(product_vv);
+    matrix.mv(vv, residual);
+    const double rho = vv.dot(residual) / norm_squared;
+    residual.axpy(-rho, product_vv);
+    product_inverse.apply(residual, riesz_residual);
+    error = std::sqrt(std::max(residual.dot(riesz_residual), 0.) / norm_squared);
+    return rho;
+  } // ... rayleigh_quotient(...)
+
+  void compute_bounding_box(const size_t qq, const InverseType& product_inverse)
+  {
+    const MatrixType& component = *components_[qq];
+    VectorType tmp(product_->rows());
+    VectorType largest;
+    VectorType smallest;
+    // X^-1 A_q is symmetric w.r.t. X and has the eigenvalues of A_q v = lambda X v
+    lanczos([&](const VectorType& source, VectorType& range) {
+              component.mv(source, tmp);
+              product_inverse.apply(tmp, range);
+            },
+            true, largest, smallest);
+    double min_error = 0.;
+    double max_error = 0.;
+    sigma_min_[qq] = rayleigh_quotient(component, product_inverse, smallest, min_error) - min_error;
+    sigma_max_[qq] = rayleigh_quotient(component, product_inverse, largest, max_error) + max_error;
+  } // ... compute_bounding_box(...)
+
+  void compute_alpha(const size_t kk, const InverseType& product_inverse)
+  {
+    const auto thetas = evaluate(training_parameters_[kk]);
+    training_thetas_[kk] = thetas;
+    const auto matrix = std::make_shared< MatrixType >(op_.freeze_parameter(training_parameters_[kk]));
+    const auto inverse = Operators::MatrixBasedDefault< MatrixType, VectorType >(matrix).invert(solver_type_);
+    VectorType tmp(product_->rows());
+    VectorType vv;
+    VectorType unused;
+    // the largest eigenvalue of A(mu_k)^-1 X (symmetric w.r.t. X) is 1 / alpha(mu_k)
+    lanczos([&](const VectorType& source, VectorType& range) {
+              product_->mv(source, tmp);
+              inverse.apply(tmp, range);
+            },
+            false, vv, unused);
+    // the Rayleigh quotient is an upper estimate of alpha(mu_k), lower it by the residual bound
+    double error = 0.;
+    alphas_[kk] = rayleigh_quotient(*matrix, product_inverse, vv, error) - error;
+    VectorType product_vv(vv.size());
+    product_->mv(vv, product_vv);
+    const double norm_squared = vv.dot(product_vv);
+    rayleigh_quotients_[kk].resize(components_.size());
+    for (size_t qq = 0; qq < components_.size(); ++qq) {
+      components_[qq]->mv(vv, tmp);
+      rayleigh_quotients_[kk][qq] = vv.dot(tmp) / norm_squared;
+    }
+  } // ... compute_alpha(...)
+
+  const LA::AffinelyDecomposedConstContainer< MatrixType > op_;
+  const std::shared_ptr< const MatrixType > product_;
+  const size_t num_neighbors_;
+  const double tolerance_;
+  const size_t max_iterations_;
+  const std::string solver_type_;
+  std::vector< std::shared_ptr< const MatrixType > > components_;
+  std::vector< double > sigma_min_;
+  std::vector< double > sigma_max_;
+  std::vector< FlatParameter > training_parameters_;
+  std::vector< double > alphas_;
+  std::vector< std::vector< double > > training_thetas_;
+  std::vector< std::vector< double > > rayleigh_quotients_;
+}; // class SuccessiveConstraints
+
+
+} // namespace Reductors
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_REDUCTORS_SCM_HH
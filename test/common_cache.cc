@@ -0,0 +1,92 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <string>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/cache.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+
+TEST(LRUCache, evicts_least_recently_used) {
+  LRUCache< std::string, int > cache(2);
+  cache.insert("a", std::make_shared< const int >(1));
+  cache.insert("b", std::make_shared< const int >(2));
+  // touch "a", such that "b" is evicted next
+  if (!cache.get("a") || *cache.get("a") != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  cache.insert("c", std::make_shared< const int >(3));
+  if (cache.size() != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cache.size());
+  if (cache.get("b"))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!cache.get("a") || !cache.get("c"))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  size_t calls = 0;
+  const auto creator = [&]() { ++calls; return 4; };
+  if (*cache.get_or_create("d", creator) != 4 || *cache.get_or_create("d", creator) != 4 || calls != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, calls);
+  cache.set_capacity(0);
+  cache.insert("e", std::make_shared< const int >(5));
+  if (cache.size() != 0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cache.size());
+}
+
+
+TEST(ShardedCache, evicts_within_budget) {
+  // a single shard, such that the budget applies to all entries
+  ShardedCache< std::string, int > lru(2, EvictionPolicy::least_recently_used, 1);
+  lru.insert("a", std::make_shared< const int >(1), 1);
+  lru.insert("b", std::make_shared< const int >(2), 1);
+  lru.get("a");
+  lru.insert("c", std::make_shared< const int >(3), 1);
+  if (lru.get("b") || !lru.get("a") || !lru.get("c"))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  ShardedCache< std::string, int > lfu(2, EvictionPolicy::least_frequently_used, 1);
+  lfu.insert("a", std::make_shared< const int >(1), 1);
+  lfu.insert("b", std::make_shared< const int >(2), 1);
+  lfu.get("a");
+  lfu.get("a");
+  lfu.get("b");
+  lfu.insert("c", std::make_shared< const int >(3), 1);
+  if (lfu.get("b") || !lfu.get("a") || !lfu.get("c"))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const auto statistics = lfu.statistics();
+  if (statistics.evictions != 1 || statistics.entries != 2 || statistics.weight != 2 || statistics.hits != 5
+      || statistics.misses != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // entries heavier than the budget are not stored
+  lfu.insert("d", std::make_shared< const int >(4), 3);
+  if (lfu.get("d"))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+
+TEST(ShardedCache, enforces_the_budget_across_shards) {
+  ShardedCache< std::string, int > cache(4, EvictionPolicy::least_recently_used, 16);
+  for (int ii = 0; ii < 8; ++ii)
+    cache.insert(std::to_string(ii), std::make_shared< const int >(ii), 1);
+  const auto statistics = cache.statistics();
+  if (statistics.weight != 4 || statistics.entries != 4 || statistics.evictions != 4)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               statistics.weight << " " << statistics.entries << " " << statistics.evictions);
+  // the least recently used entries are evicted, regardless of their shard
+  for (int ii = 0; ii < 8; ++ii)
+    if (bool(cache.get(std::to_string(ii))) != (ii >= 4))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii);
+  // an entry as heavy as the whole budget is stored, all others are evicted
+  cache.insert("heavy", std::make_shared< const int >(8), 4);
+  if (!cache.get("heavy") || cache.statistics().entries != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cache.statistics().entries);
+  // lowering the budget evicts at once
+  cache.set_budget(3);
+  if (cache.get("heavy") || cache.statistics().weight != 0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cache.statistics().weight);
+}
@@ -0,0 +1,49 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/parallel.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+
+TEST(parallel_for, visits_each_index_once) {
+  const size_t size = 1000;
+  const size_t num_threads = 4;
+  std::vector< size_t > visits(size, 0);
+  std::vector< size_t > threads(size, num_threads);
+  parallel_for(size,
+               [&](const size_t ii, const size_t thread) {
+                 ++visits[ii];
+                 threads[ii] = thread;
+               },
+               num_threads);
+  for (size_t ii = 0; ii < size; ++ii)
+    if (visits[ii] != 1 || threads[ii] >= num_threads)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii);
+}
+
+
+TEST(parallel_for, rethrows) {
+  bool thrown = false;
+  try {
+    parallel_for(100,
+                 [](const size_t ii, const size_t /*thread*/) {
+                   if (ii == 42)
+                     DUNE_THROW(Stuff::Exceptions::wrong_input_given, ii);
+                 },
+                 3);
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    thrown = true;
+  }
+  if (!thrown)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
@@ -0,0 +1,99 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iterator>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/store.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+
+TEST(AppendOnlyStore, persists_and_rejects) {
+  const std::string filename = "common_store.dat";
+  std::remove(filename.c_str());
+  std::string value;
+  {
+    AppendOnlyStore store(filename, "discretization_a");
+    store.put("first", "1");
+    store.put("second", std::string("2\0two", 5));
+    store.put("first", "one");
+    if (store.size() != 2)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, store.size());
+  }
+  {
+    // reopening finds all values, the latest put wins
+    AppendOnlyStore store(filename, "discretization_a");
+    if (!store.get("first", value) || value != "one")
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, value);
+    if (!store.get("second", value) || value != std::string("2\0two", 5))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, value);
+    if (store.get("third", value))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  }
+  {
+    // a partially written record at the end is dropped
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
+    file << "garbage";
+  }
+  {
+    AppendOnlyStore store(filename, "discretization_a");
+    if (store.size() != 2)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, store.size());
+    store.put("third", "3");
+  }
+  {
+    AppendOnlyStore store(filename, "discretization_a");
+    if (!store.get("third", value) || value != "3")
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, value);
+  }
+  // a store of another discretization is only discarded on request
+  try {
+    AppendOnlyStore store(filename, "discretization_b");
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (IOError&) {}
+  {
+    AppendOnlyStore store(filename, "discretization_a");
+    if (store.size() != 3)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, store.size());
+  }
+  {
+    AppendOnlyStore store(filename, "discretization_b", true);
+    if (store.size() != 0 || store.contains("first"))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, store.size());
+  }
+  std::remove(filename.c_str());
+}
+
+
+TEST(AppendOnlyStore, leaves_foreign_files_alone) {
+  const std::string filename = "common_store_foreign.dat";
+  const std::string contents = "some precious data";
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << contents;
+  }
+  try {
+    AppendOnlyStore store(filename, "discretization_a");
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (IOError&) {}
+  // not even on request
+  try {
+    AppendOnlyStore store(filename, "discretization_a", true);
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (IOError&) {}
+  std::ifstream file(filename, std::ios::binary);
+  const std::string read((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+  if (read != contents)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, read);
+  std::remove(filename.c_str());
+}
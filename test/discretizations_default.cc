@@ -0,0 +1,103 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/common.hh>
+
+#include <dune/pymor/operators/base.hh>
+#include <dune/pymor/discretizations/default.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseMatrix< double > TestMatrixType;
+typedef Stuff::LA::CommonDenseVector< double > TestVectorType;
+
+static const size_t test_dim = 3;
+
+
+class CountingDiscretization;
+
+
+class CountingDiscretizationTraits
+{
+public:
+  typedef CountingDiscretization                                         derived_type;
+  typedef Operators::MatrixBasedDefault< TestMatrixType, TestVectorType > OperatorType;
+  typedef OperatorType                                                   FunctionalType;
+  typedef OperatorType                                                   ProductType;
+  typedef TestVectorType                                                 VectorType;
+}; // class CountingDiscretizationTraits
+
+
+/**
+ * \brief Solves to (mu, mu + 1, mu + 2) and counts the calls to uncached_solve().
+ */
+class CountingDiscretization
+  : public StationaryDiscretization::CachingDefault< CountingDiscretizationTraits >
+{
+  typedef StationaryDiscretization::CachingDefault< CountingDiscretizationTraits > BaseType;
+public:
+  CountingDiscretization()
+    : BaseType(ParameterType("mu", 1))
+    , num_solves(0)
+  {}
+
+  std::vector< std::string > solver_types() const
+  {
+    return {"first", "second"};
+  }
+
+  DSC::Configuration solver_options(const std::string type) const
+  {
+    return DSC::Configuration("type", type);
+  }
+
+  TestVectorType create_vector() const
+  {
+    return TestVectorType(test_dim);
+  }
+
+  void uncached_solve(const DSC::Configuration /*options*/, TestVectorType& vector, const Parameter mu) const
+  {
+    ++num_solves;
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      vector.set_entry(ii, mu.get("mu")[0] + double(ii));
+  }
+
+  mutable std::atomic< size_t > num_solves;
+}; // class CountingDiscretization
+
+
+TEST(CachingDefault, caches_all_solves) {
+  const CountingDiscretization discretization;
+  TestVectorType vector(test_dim);
+  discretization.solve(vector, Parameter("mu", 1.));
+  discretization.solve(vector, Parameter("mu", 1.));
+  if (discretization.num_solves != 1 || vector.get_entry(2) != 3.)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, discretization.num_solves);
+  // other solver options are cached separately
+  discretization.solve("second", vector, Parameter("mu", 1.));
+  if (discretization.num_solves != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, discretization.num_solves);
+  // the batch solves go through the cache as well
+  const std::vector< Parameter > mus = {Parameter("mu", 1.), Parameter("mu", 2.), Parameter("mu", 1.)};
+  const auto multi_vector = discretization.solve_multi(mus, 2);
+  if (discretization.num_solves != 3)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, discretization.num_solves);
+  for (size_t ii = 0; ii < mus.size(); ++ii)
+    if (multi_vector.column(ii)[0] != mus[ii].get("mu")[0])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii);
+  const auto vectors = discretization.solve_many({Parameter("mu", 2.), Parameter("mu", 3.)});
+  if (discretization.num_solves != 4 || vectors[1].get_entry(0) != 3.)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, discretization.num_solves);
+}
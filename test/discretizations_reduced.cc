@@ -0,0 +1,80 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/discretizations/reduced.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseMatrix< double > MatrixType;
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+static const size_t test_size = 3;
+
+
+static std::shared_ptr< MatrixType > create_matrix(const double diagonal, const double off_diagonal)
+{
+  auto ret = std::make_shared< MatrixType >(test_size, test_size);
+  for (size_t ii = 0; ii < test_size; ++ii)
+    for (size_t jj = 0; jj < test_size; ++jj)
+      ret->set_entry(ii, jj, ii == jj ? diagonal : off_diagonal * double(ii + 2 * jj));
+  return ret;
+}
+
+
+static std::shared_ptr< VectorType > create_vector(const double factor)
+{
+  auto ret = std::make_shared< VectorType >(test_size);
+  for (size_t ii = 0; ii < test_size; ++ii)
+    ret->set_entry(ii, factor * double(ii + 1));
+  return ret;
+}
+
+
+template< size_t N >
+static void check_solve()
+{
+  LA::AffinelyDecomposedContainer< MatrixType > op(create_matrix(4., 0.1));
+  op.register_component(create_matrix(1., -0.2), new ParameterFunctional("diffusion", 1, "diffusion"));
+  LA::AffinelyDecomposedContainer< VectorType > rhs;
+  rhs.register_component(create_vector(1.), new ParameterFunctional("force", 2, "force[0]"));
+  rhs.register_component(create_vector(-1.), new ParameterFunctional("force", 2, "force[1] * force[1]"));
+  const StationaryDiscretization::ReducedDense< double, N > reduced(op, rhs);
+  VectorType solution;
+  for (const double value : {0.5, 2., 10.}) {
+    const Parameter mu = {{"diffusion", "force"}, {{value}, {value, 1.}}};
+    reduced.solve(FlatParameter(mu), solution);
+    // check the residual
+    VectorType residual(test_size);
+    op.freeze_parameter(mu).mv(solution, residual);
+    residual.axpy(-1., rhs.freeze_parameter(mu));
+    if (residual.sup_norm() > 1e-12)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, residual.sup_norm());
+    if (!reduced.solve(mu).almost_equal(solution))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, value);
+  }
+} // ... check_solve(...)
+
+
+TEST(ReducedDense, solve_dynamic_size) {
+  check_solve< 0 >();
+}
+
+
+TEST(ReducedDense, solve_fixed_size) {
+  check_solve< test_size >();
+}
@@ -0,0 +1,66 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/common.hh>
+
+#include <dune/pymor/discretizations/snapshots.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+
+// run with mpirun -np N to test the distribution, works with any N
+static void check_snapshots(const bool dynamic)
+{
+  const size_t num = 23;
+  const size_t dim = 3;
+  const auto snapshots = compute_snapshots< VectorType >(num,
+                                                         [&](const size_t ii) {
+                                                           VectorType vector(dim);
+                                                           for (size_t jj = 0; jj < dim; ++jj)
+                                                             vector.set_entry(jj, double(ii * dim + jj));
+                                                           return vector;
+                                                         },
+                                                         MPIHelper::getCommunicator(),
+                                                         dynamic);
+  if (snapshots.size() != num
+      || snapshots.local_vectors().size() != snapshots.local_indices().size()
+      || snapshots.local_timings().size() != snapshots.local_indices().size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, snapshots.local_indices().size());
+  for (size_t ii = 0; ii < snapshots.local_indices().size(); ++ii)
+    if (snapshots.local_vectors()[ii].get_entry(0) != double(snapshots.local_indices()[ii] * dim))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii);
+  const auto vectors = snapshots.gather(0);
+  if (MPIHelper::getCollectiveCommunication().rank() != 0) {
+    if (!vectors.empty())
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, vectors.size());
+    return;
+  }
+  if (vectors.size() != num)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, vectors.size());
+  for (size_t ii = 0; ii < num; ++ii)
+    for (size_t jj = 0; jj < dim; ++jj)
+      if (vectors[ii].get_entry(jj) != double(ii * dim + jj))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii << ", " << jj);
+} // ... check_snapshots(...)
+
+
+TEST(compute_snapshots, dynamic) {
+  check_snapshots(true);
+}
+
+
+TEST(compute_snapshots, static) {
+  check_snapshots(false);
+}
@@ -0,0 +1,191 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/test/la_container.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/la/container/lincomb.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+static const size_t test_dim = 4;
+
+
+typedef testing::Types<
+                        Stuff::LA::CommonDenseVector< double >
+                      , Stuff::LA::CommonDenseMatrix< double >
+#if HAVE_EIGEN
+                      , Stuff::LA::EigenDenseVector< double >
+                      , Stuff::LA::EigenDenseMatrix< double >
+                      , Stuff::LA::EigenRowMajorSparseMatrix< double >
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+                      , Stuff::LA::IstlDenseVector< double >
+                      , Stuff::LA::IstlRowMajorSparseMatrix< double >
+#endif
+                      > ContainerTypes;
+
+
+template< class ContainerType >
+struct AffinelyDecomposedContainerTest
+  : public ::testing::Test
+{
+  typedef LA::AffinelyDecomposedConstContainer< ContainerType > AffinelyDecomposedContainerType;
+
+  static std::shared_ptr< const ContainerType > create(const double factor)
+  {
+    auto ret = std::make_shared< ContainerType >(ContainerFactory< ContainerType >::create(test_dim));
+    ret->scal(factor);
+    return ret;
+  }
+
+  template< class CC, bool vector = std::is_base_of< Stuff::LA::Tags::VectorInterface, CC >::value >
+  struct SupNorm
+  {
+    static double compute(const CC& vector)
+    {
+      return vector.sup_norm();
+    }
+  };
+
+  template< class CC >
+  struct SupNorm< CC, false >
+  {
+    static double compute(const CC& matrix)
+    {
+      double ret = 0.;
+      for (size_t ii = 0; ii < matrix.rows(); ++ii)
+        for (size_t jj = 0; jj < matrix.cols(); ++jj)
+          ret = std::max(ret, std::abs(matrix.get_entry(ii, jj)));
+      return ret;
+    }
+  };
+
+  static double difference(const ContainerType& actual, const ContainerType& expected)
+  {
+    auto tmp = actual.copy();
+    tmp.axpy(-1., expected);
+    return SupNorm< ContainerType >::compute(tmp);
+  }
+
+  void freeze_parameter() const
+  {
+    const auto affine_part = create(1.);
+    const auto first_component = create(2.);
+    const auto second_component = create(-3.);
+    const auto third_component = create(0.5);
+    AffinelyDecomposedContainerType container(affine_part);
+    container.register_component(first_component, new ParameterFunctional("diffusion", 1, "diffusion"));
+    container.register_component(second_component, new ParameterFunctional("force", 2, "force[0] * force[1]"));
+    container.register_component(third_component, new ParameterFunctional("diffusion", 1, "exp(diffusion)"));
+    const Parameter mu = {{"diffusion", "force"}, {{0.5}, {2.0, 3.0}}};
+    const std::vector< double > thetas = {1., 0.5, 6.0, std::exp(0.5)};
+    // reference
+    auto expected = affine_part->copy();
+    expected.axpy(thetas[1], *first_component);
+    expected.axpy(thetas[2], *second_component);
+    expected.axpy(thetas[3], *third_component);
+    // assembled
+    const auto frozen = container.freeze_parameter(mu);
+    if (difference(frozen, expected) > 1e-13)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference(frozen, expected));
+    const auto combined = LA::lincomb< ContainerType >(
+          {affine_part, first_component, second_component, third_component}, thetas);
+    if (difference(combined, expected) > 1e-13)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference(combined, expected));
+    // assembling again reuses any cached structure
+    const Parameter mu2 = {{"diffusion", "force"}, {{-1.0}, {1.0, 0.0}}};
+    auto expected2 = affine_part->copy();
+    expected2.axpy(-1., *first_component);
+    expected2.axpy(std::exp(-1.), *third_component);
+    const auto frozen2 = container.freeze_parameter(mu2);
+    if (difference(frozen2, expected2) > 1e-13)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference(frozen2, expected2));
+    // as well as registering another component
+    container.register_component(create(1.), new ParameterFunctional("force", 2, "force[0]"));
+    expected2.axpy(1., *create(1.));
+    const auto frozen3 = container.freeze_parameter(mu2);
+    if (difference(frozen3, expected2) > 1e-13)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference(frozen3, expected2));
+  } // ... freeze_parameter(...)
+
+  void freeze_parameter_into() const
+  {
+    const auto affine_part = create(1.);
+    const auto component = create(2.);
+    AffinelyDecomposedContainerType container(affine_part);
+    container.register_component(component, new ParameterFunctional("diffusion", 1, "diffusion"));
+    // target of wrong shape is replaced
+    ContainerType target = ContainerFactory< ContainerType >::create(1);
+    for (const double value : {0.5, -2., 3.}) {
+      const Parameter mu("diffusion", value);
+      auto expected = affine_part->copy();
+      expected.axpy(value, *component);
+      container.freeze_parameter_into(mu, target);
+      if (difference(target, expected) > 1e-13)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference(target, expected));
+    }
+  } // ... freeze_parameter_into(...)
+}; // struct AffinelyDecomposedContainerTest
+
+
+TYPED_TEST_CASE(AffinelyDecomposedContainerTest, ContainerTypes);
+TYPED_TEST(AffinelyDecomposedContainerTest, freeze_parameter) {
+  this->freeze_parameter();
+}
+TYPED_TEST(AffinelyDecomposedContainerTest, freeze_parameter_into) {
+  this->freeze_parameter_into();
+}
+
+
+#if HAVE_DUNE_ISTL
+
+
+TEST(AffinelyDecomposedContainerIstl, changed_pattern)
+{
+  typedef Stuff::LA::IstlRowMajorSparseMatrix< double > MatrixType;
+  const auto column = [](const size_t ii, const bool diagonal) { return diagonal ? ii : test_dim - 1 - ii; };
+  const auto create = [&](const bool diagonal) {
+    Stuff::LA::SparsityPatternDefault pattern(test_dim);
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      pattern.insert(ii, column(ii, diagonal));
+    pattern.sort();
+    MatrixType ret(test_dim, test_dim, pattern);
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      ret.set_entry(ii, column(ii, diagonal), double(ii + 1));
+    return ret;
+  };
+  LA::AffinelyDecomposedContainer< MatrixType > container(new MatrixType(create(true)));
+  container.register_component(new MatrixType(create(true)), new ParameterFunctional("diffusion", 1, "diffusion"));
+  const Parameter mu("diffusion", 2.);
+  container.freeze_parameter(mu);
+  // same number of nonzeroes, but a different pattern
+  *container.component(0) = create(false);
+  const auto frozen = container.freeze_parameter(mu);
+  for (size_t ii = 0; ii < test_dim; ++ii)
+    for (size_t jj = 0; jj < test_dim; ++jj) {
+      const double expected = (jj == column(ii, true) ? double(ii + 1) : 0.)
+                              + (jj == column(ii, false) ? 2. * double(ii + 1) : 0.);
+      if (frozen.get_entry(ii, jj) != expected)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   ii << ", " << jj << ": " << frozen.get_entry(ii, jj));
+    }
+}
+
+
+#endif // HAVE_DUNE_ISTL
@@ -0,0 +1,139 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/la/container/multivector.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+typedef LA::MultiVector< double >              MultiVectorType;
+
+static const size_t test_dim = 7;
+
+
+static VectorType create_vector(const double offset)
+{
+  VectorType ret(test_dim);
+  for (size_t kk = 0; kk < test_dim; ++kk)
+    ret.set_entry(kk, offset + std::sin(double(kk + 1) * offset));
+  return ret;
+}
+
+static MultiVectorType create_multi_vector(const size_t len, const double offset = 0.)
+{
+  MultiVectorType ret(test_dim);
+  for (size_t ii = 0; ii < len; ++ii)
+    ret.append(create_vector(offset + double(ii)));
+  return ret;
+}
+
+static void check(const bool condition)
+{
+  if (!condition)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+
+TEST(MultiVector, storage)
+{
+  auto vectors = create_multi_vector(5);
+  check(vectors.dim() == test_dim && vectors.len() == 5);
+  VectorType vector(test_dim);
+  for (size_t ii = 0; ii < 5; ++ii) {
+    vectors.get(ii, vector);
+    check(vector == create_vector(double(ii)));
+    for (size_t kk = 0; kk < test_dim; ++kk)
+      check(vectors.data()[ii * test_dim + kk] == vector.get_entry(kk));
+  }
+  const auto copied = vectors.copy({4, 1});
+  check(copied.len() == 2);
+  copied.get(0, vector);
+  check(vector == create_vector(4.));
+  vectors.remove({0, 2});
+  check(vectors.len() == 3);
+  vectors.get(1, vector);
+  check(vector == create_vector(3.));
+  vectors.append(copied);
+  check(vectors.len() == 5);
+  vectors.get(4, vector);
+  check(vector == create_vector(1.));
+  vectors.append(vectors, {4});
+  check(vectors.len() == 6);
+  vectors.get(5, vector);
+  check(vector == create_vector(1.));
+  vectors.remove({5});
+  vectors.set(0, create_vector(42.));
+  vectors.get(0, vector);
+  check(vector == create_vector(42.));
+  EXPECT_THROW(vectors.get(5, vector), Stuff::Exceptions::index_out_of_range);
+  EXPECT_THROW(vectors.append(VectorType(test_dim + 1)), Stuff::Exceptions::shapes_do_not_match);
+}
+
+TEST(MultiVector, products)
+{
+  const size_t len = 6;
+  const auto vectors = create_multi_vector(len);
+  const auto others = create_multi_vector(len - 1, 0.5);
+  const auto products = vectors.dot(others);
+  const auto gramian = vectors.gramian();
+  const auto pairwise = vectors.pairwise_dot(create_multi_vector(len, 0.5));
+  const auto norms = vectors.l2_norm();
+  check(size_t(products.rows()) == len && size_t(products.cols()) == len - 1);
+  for (size_t ii = 0; ii < len; ++ii) {
+    const auto vv = create_vector(double(ii));
+    for (size_t jj = 0; jj + 1 < len; ++jj)
+      check(Dune::FloatCmp::eq(products.get_entry(ii, jj), vv.dot(create_vector(0.5 + double(jj)))));
+    for (size_t jj = 0; jj < len; ++jj)
+      check(Dune::FloatCmp::eq(gramian.get_entry(ii, jj), vv.dot(create_vector(double(jj)))));
+    check(Dune::FloatCmp::eq(pairwise[ii], vv.dot(create_vector(0.5 + double(ii)))));
+    check(Dune::FloatCmp::eq(norms[ii], vv.l2_norm()));
+  }
+  const auto flat_products = vectors.pb_dot(others);
+  check(flat_products.dim() == len - 1 && flat_products.len() == len);
+  for (size_t ii = 0; ii < len; ++ii)
+    for (size_t jj = 0; jj + 1 < len; ++jj)
+      check(flat_products.column(ii)[jj] == products.get_entry(ii, jj));
+}
+
+TEST(MultiVector, lincomb_and_axpy)
+{
+  const size_t len = 4;
+  const auto vectors = create_multi_vector(len);
+  MultiVectorType::MatrixType coefficients(2, len);
+  for (size_t ii = 0; ii < 2; ++ii)
+    for (size_t jj = 0; jj < len; ++jj)
+      coefficients.set_entry(ii, jj, double(ii + 1) - 0.5 * double(jj));
+  const auto combinations = vectors.lincomb(coefficients);
+  check(combinations.len() == 2);
+  VectorType vector(test_dim);
+  for (size_t ii = 0; ii < 2; ++ii) {
+    VectorType expected(test_dim, 0.);
+    for (size_t jj = 0; jj < len; ++jj)
+      expected.axpy(coefficients.get_entry(ii, jj), create_vector(double(jj)));
+    combinations.get(ii, vector);
+    check(vector.almost_equal(expected));
+  }
+  auto result = vectors.copy();
+  result.axpy(std::vector< double >({1., 2., 3., 4.}), create_multi_vector(1, 10.));
+  result.scal(0.5);
+  for (size_t ii = 0; ii < len; ++ii) {
+    auto expected = create_vector(double(ii));
+    expected.axpy(double(ii + 1), create_vector(10.));
+    expected.scal(0.5);
+    result.get(ii, vector);
+    check(vector.almost_equal(expected));
+  }
+  EXPECT_THROW(result.axpy(1., create_multi_vector(2)), Stuff::Exceptions::shapes_do_not_match);
+}
@@ -5,7 +5,11 @@
 
 #include <dune/stuff/test/main.hxx>
 
+#include <algorithm>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include <type_traits>
 
 #include <dune/common/float_cmp.hh>
@@ -107,6 +111,242 @@ TYPED_TEST(MatrixBasedOperatorTests, fulfills_interface) {
   this->fulfills_interface();
 }
 
+#if HAVE_EIGEN
+
+TEST(MatrixBasedInverseDefault, detects_singular_matrices) {
+  typedef Stuff::LA::EigenDenseMatrix< double > MatrixType;
+  typedef Stuff::LA::EigenDenseVector< double > VectorType;
+  const Operators::MatrixBasedDefault< MatrixType, VectorType > op(new MatrixType(test_dim, test_dim, 0.));
+  const VectorType rhs(test_dim, 1.);
+  for (const std::string type : {"lu.partialpiv", "lu.fullpiv", "llt"}) {
+    VectorType solution(test_dim);
+    try {
+      op.apply_inverse(rhs, solution, type);
+    } catch (Stuff::Exceptions::linear_solver_failed) {
+      continue;
+    }
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, type << " did not detect the singular matrix!");
+  }
+}
+
+#endif // HAVE_EIGEN
+
+
+template< class MatrixBasedOperatorType >
+struct LinearAffinelyDecomposedContainerBasedTest
+  : public ::testing::Test
+{
+  typedef typename MatrixBasedOperatorType::ContainerType MatrixType;
+  typedef typename MatrixBasedOperatorType::SourceType    VectorType;
+  typedef Operators::LinearAffinelyDecomposedContainerBased< MatrixType, VectorType > OperatorType;
+
+  void matrix_free_apply() const
+  {
+    LA::AffinelyDecomposedConstContainer< MatrixType > container(
+          new MatrixType(ContainerFactory< MatrixType >::create(test_dim)));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(test_dim)),
+                                 new ParameterFunctional("diffusion", 1, "diffusion"));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(test_dim)),
+                                 new ParameterFunctional("force", 2, "force[0] - force[1]"));
+    OperatorType assembled(container);
+    OperatorType matrix_free(container, true);
+    if (assembled.matrix_free() || !matrix_free.matrix_free())
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+    const Parameter mu = {{"diffusion", "force"}, {{2.0}, {1.0, 4.0}}};
+    const VectorType source = ContainerFactory< VectorType >::create(test_dim);
+    VectorType expected(test_dim);
+    VectorType result(test_dim);
+    assembled.apply(source, expected, mu);
+    matrix_free.apply(source, result, mu);
+    result.axpy(-1., expected);
+    if (result.sup_norm() > 1e-13)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, result.sup_norm());
+  } // ... matrix_free_apply(...)
+
+  void concurrent_matrix_free_apply() const
+  {
+    typedef typename OperatorType::MultiVectorType MultiVectorType;
+    // large enough for the applications of the threads to overlap
+    const size_t dim = 100;
+    LA::AffinelyDecomposedConstContainer< MatrixType > container(
+          new MatrixType(ContainerFactory< MatrixType >::create(dim)));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(dim)),
+                                 new ParameterFunctional("diffusion", 1, "diffusion"));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(dim)),
+                                 new ParameterFunctional("force", 1, "force^2"));
+    const OperatorType assembled(container);
+    const OperatorType matrix_free(container, true);
+    const VectorType source = ContainerFactory< VectorType >::create(dim);
+    MultiVectorType sources(dim);
+    sources.append(source);
+    sources.append(source);
+    // all threads apply the same operator, each for its own parameter
+    std::vector< double > errors(4, 0.);
+    std::vector< std::thread > threads;
+    for (size_t tt = 0; tt < errors.size(); ++tt)
+      threads.emplace_back([&, tt]() {
+        const Parameter mu(std::vector< std::string >{"diffusion", "force"},
+                           std::vector< std::vector< double > >{{double(tt + 1)}, {double(2*tt)}});
+        const VectorType expected = assembled.apply(source, mu);
+        const double scale = std::max(1., expected.sup_norm());
+        VectorType range(dim);
+        MultiVectorType ranges(dim, sources.len());
+        for (size_t ii = 0; ii < 1000; ++ii) {
+          matrix_free.apply(source, range, mu);
+          range.axpy(-1., expected);
+          errors[tt] = std::max(errors[tt], range.sup_norm() / scale);
+          matrix_free.apply(sources, ranges, mu);
+          for (size_t jj = 0; jj < ranges.len(); ++jj) {
+            ranges.get(jj, range);
+            range.axpy(-1., expected);
+            errors[tt] = std::max(errors[tt], range.sup_norm() / scale);
+          }
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    for (size_t tt = 0; tt < errors.size(); ++tt)
+      if (errors[tt] > 1e-13)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, tt << ": " << errors[tt]);
+  } // ... concurrent_matrix_free_apply(...)
+
+  void cached_invert() const
+  {
+    LA::AffinelyDecomposedConstContainer< MatrixType > container(
+          new MatrixType(ContainerFactory< MatrixType >::create(test_dim)));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(test_dim)),
+                                 new ParameterFunctional("diffusion", 1, "diffusion"));
+    OperatorType cached(container);
+    OperatorType uncached(container);
+    if (cached.inverse_cache_size() != 0)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cached.inverse_cache_size());
+    cached.set_inverse_cache_size(1);
+    if (cached.inverse_cache_size() != 1)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, cached.inverse_cache_size());
+    const VectorType rhs = ContainerFactory< VectorType >::create(test_dim);
+    // not every solver type has to support every matrix, but at least one has to
+    size_t num_solved = 0;
+    for (const auto& type : cached.invert_options()) {
+      try {
+        for (const double value : {1.0, 2.0, 1.0}) {
+          const Parameter mu("diffusion", value);
+          VectorType expected(test_dim);
+          VectorType result(test_dim);
+          uncached.apply_inverse(rhs, expected, type, mu);
+          cached.apply_inverse(rhs, result, type, mu);
+          result.axpy(-1., expected);
+          if (result.sup_norm() > 1e-10)
+            DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, type << ": " << result.sup_norm());
+        }
+        ++num_solved;
+      } catch (Stuff::Exceptions::linear_solver_failed) {}
+    }
+    if (num_solved == 0)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "none of the solver types succeeded!");
+  } // ... cached_invert(...)
+
+  void multiple_vectors() const
+  {
+    LA::AffinelyDecomposedConstContainer< MatrixType > container(
+          new MatrixType(ContainerFactory< MatrixType >::create(test_dim)));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(test_dim)),
+                                 new ParameterFunctional("diffusion", 1, "diffusion"));
+    const OperatorType op(container);
+    const Parameter mu("diffusion", 3.);
+    std::vector< VectorType > sources;
+    for (size_t ii = 0; ii < 3; ++ii) {
+      sources.emplace_back(ContainerFactory< VectorType >::create(test_dim));
+      sources.back().scal(double(ii + 1));
+    }
+    const auto ranges = op.apply(sources, mu);
+    if (ranges.size() != sources.size())
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ranges.size());
+    for (size_t ii = 0; ii < sources.size(); ++ii) {
+      auto difference = op.apply(sources[ii], mu);
+      difference.axpy(-1., ranges[ii]);
+      if (difference.sup_norm() > 1e-13)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference.sup_norm());
+    }
+    size_t num_solved = 0;
+    for (const auto& type : op.invert_options()) {
+      try {
+        const auto solutions = op.apply_inverse(ranges, type, mu);
+        for (size_t ii = 0; ii < ranges.size(); ++ii) {
+          auto difference = op.apply_inverse(ranges[ii], type, mu);
+          difference.axpy(-1., solutions[ii]);
+          if (difference.sup_norm() > 1e-10)
+            DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, type << ": " << difference.sup_norm());
+        }
+        ++num_solved;
+      } catch (Stuff::Exceptions::linear_solver_failed) {}
+    }
+    if (num_solved == 0)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "none of the solver types succeeded!");
+  } // ... multiple_vectors(...)
+
+  void multi_vector_apply() const
+  {
+    typedef typename OperatorType::MultiVectorType MultiVectorType;
+    LA::AffinelyDecomposedConstContainer< MatrixType > container(
+          new MatrixType(ContainerFactory< MatrixType >::create(test_dim)));
+    container.register_component(new MatrixType(ContainerFactory< MatrixType >::create(test_dim)),
+                                 new ParameterFunctional("force", 2, "force[0] - force[1]"));
+    OperatorType assembled(container);
+    OperatorType matrix_free(container, true);
+    const auto affine_part = assembled.affine_part();
+    const Parameter mu = {"force", {1.0, 4.0}};
+    MultiVectorType sources(test_dim);
+    for (size_t ii = 0; ii < 3; ++ii) {
+      auto source = ContainerFactory< VectorType >::create(test_dim);
+      source.scal(double(ii + 1));
+      sources.append(source);
+    }
+    const auto assembled_ranges = assembled.apply(sources, mu);
+    const auto matrix_free_ranges = matrix_free.apply(sources, mu);
+    const auto affine_ranges = affine_part.apply(sources);
+    VectorType source(test_dim);
+    VectorType range(test_dim);
+    for (size_t ii = 0; ii < sources.len(); ++ii) {
+      sources.get(ii, source);
+      const auto expected = assembled.apply(source, mu);
+      for (const auto* ranges : {&assembled_ranges, &matrix_free_ranges}) {
+        ranges->get(ii, range);
+        range.axpy(-1., expected);
+        if (range.sup_norm() > 1e-13)
+          DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, range.sup_norm());
+      }
+      affine_ranges.get(ii, range);
+      range.axpy(-1., affine_part.apply(source));
+      if (range.sup_norm() > 1e-13)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, range.sup_norm());
+    }
+    MultiVectorType wrong_ranges(test_dim + 1, sources.len());
+    EXPECT_THROW(assembled.apply(sources, wrong_ranges, mu), Stuff::Exceptions::shapes_do_not_match);
+  } // ... multi_vector_apply(...)
+}; // struct LinearAffinelyDecomposedContainerBasedTest
+
+
+TYPED_TEST_CASE(LinearAffinelyDecomposedContainerBasedTest, MatrixBasedOperatorTypes);
+TYPED_TEST(LinearAffinelyDecomposedContainerBasedTest, matrix_free_apply) {
+  this->matrix_free_apply();
+}
+
+TYPED_TEST(LinearAffinelyDecomposedContainerBasedTest, concurrent_matrix_free_apply) {
+  this->concurrent_matrix_free_apply();
+}
+
+TYPED_TEST(LinearAffinelyDecomposedContainerBasedTest, cached_invert) {
+  this->cached_invert();
+}
+
+TYPED_TEST(LinearAffinelyDecomposedContainerBasedTest, multiple_vectors) {
+  this->multiple_vectors();
+}
+
+TYPED_TEST(LinearAffinelyDecomposedContainerBasedTest, multi_vector_apply) {
+  this->multi_vector_apply();
+}
+
 
 //template< class OperatorImp >
 //struct LinearAffinelyDecomposedContainerBasedOperatorTest
@@ -94,6 +94,17 @@ TEST(Parameter, Parameters_Base)
   if (param1.get("force") != ValueType({1.0, 2.0})) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
   if (param1 != param2) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
   if (!(param1 == param2)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  param1.deserialize({3.0, 4.0, 5.0});
+  if (param1.type() != type2) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (param1.get("force") != ValueType({4.0, 5.0})) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (param1.values()[0] != ValueType({3.0})) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (param1.serialize() != ValueType({3.0, 4.0, 5.0}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  EXPECT_THROW(param1.deserialize({1.0, 2.0}), Stuff::Exceptions::shapes_do_not_match);
+  const double serialized[] = {6.0, 7.0, 8.0};
+  param1.deserialize(serialized, 3);
+  if (param1.serialize() != ValueType({6.0, 7.0, 8.0}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
   //  DSC_LOG_DEBUG << param2 << std::endl;
 }
 
@@ -111,8 +122,10 @@ TEST(Parametric, Parameters_Base)
                           {{1.0},          {1.0, 2.0, 3.0}}};
       Parameter mu = {{"diffusion", "first_force", "second_force"},
                      {{1.0, 2.0},   {1.0},         {1.0, 2.0, 3.0}}};
-      inherit_parameter_type(muDiffusion, "a");
-      inherit_parameter_type(muForce, "b");
+      const size_t indexDiffusion = inherit_parameter_type(muDiffusion, "a");
+      const size_t indexForce = inherit_parameter_type(muForce, "b");
+      if (indexDiffusion != 0 || indexForce != 1 || inherit_parameter_type(muDiffusion, "a") != 0)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
       const ParameterType& typeDiffusion = map_parameter_type("a");
       if (typeDiffusion != muDiffusion.type()) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
       const ParameterType& typeForce = map_parameter_type("b");
@@ -121,8 +134,45 @@ TEST(Parametric, Parameters_Base)
       if (mappedMuDiffusion != muDiffusion) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
       const Parameter mappedMuForce = map_parameter(mu, "b");
       if (mappedMuForce != muForce) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+      const FlatParameter flatMuForce = map_parameter(FlatParameter(mu), "b");
+      if (flatMuForce != FlatParameter(muForce)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+      const auto& projection = parameter_projection(indexForce);
+      if (projection.identity() || projection.dim() != 4)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+      const auto serializedMu = mu.serialize();
+      std::vector< double > scratch(projection.dim());
+      const double* mappedForce = projection.map(serializedMu.data(), scratch.data());
+      if (std::vector< double >(mappedForce, mappedForce + 4) != muForce.serialize())
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+      // inheriting ids without changing the parameter type keeps the existing projections in place
+      for (size_t ii = 0; ii < 100; ++ii)
+        parameter_projection(inherit_parameter_type(muDiffusion, "c" + std::to_string(ii)));
+      if (&parameter_projection(indexForce) != &projection || projection.dim() != 4)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
     }
   };
 
   Foo DUNE_UNUSED(foo);
 }
+
+TEST(FlatParameter, Parameters_Base)
+{
+  const ParameterType type = {{"diffusion", "force"}, {1, 2}};
+  const auto& layout = *type.layout();
+  if (layout.dim() != 3) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, layout.dim());
+  if (layout.offset("diffusion") != 0 || layout.offset("force") != 1 || layout.size("force") != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const Parameter mu = {{"diffusion", "force"}, {{1.0}, {2.0, 3.0}}};
+  const FlatParameter flat_mu(mu);
+  if (!flat_mu.has_type(type)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (flat_mu.values() != mu.serialize()) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (flat_mu.get("force")[1] != 3.0) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (flat_mu.parameter() != mu) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const FlatParameter same_mu(type, {1.0, 2.0, 3.0});
+  if (same_mu != flat_mu || same_mu.hash() != flat_mu.hash())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const FlatParameter other_mu(type, {1.0, 2.0, 4.0});
+  if (other_mu == flat_mu || !(flat_mu < other_mu)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const FlatParameter other_type_mu(ParameterType({"diffusion", "force"}, {2, 1}), {1.0, 2.0, 3.0});
+  if (other_type_mu == flat_mu) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
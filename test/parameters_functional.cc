@@ -5,9 +5,16 @@
 
 #include <dune/stuff/test/main.hxx>
 
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <dune/stuff/common/float_cmp.hh>
 #include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/expression/mathexpr.hh>
 
+#include <dune/pymor/parameters/expression.hh>
 #include <dune/pymor/parameters/functional.hh>
 
 using namespace Dune;
@@ -35,3 +42,110 @@ TEST(Functional, Parameters_Functional)
   if (exp != "diffusion + sin(force[0]) + exp(force[1])")
     DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
 }
+
+TEST(Functional, Parameters_Functional_Compiled)
+{
+  const Parameter mu = {{"diffusion", "force"}, {{2.0}, {0.5, 3.0}}};
+  const ParameterFunctional theta(mu.type(), "-diffusion^2 * force[0] + max(force[1], 1.0) / (1 + abs(force[0]))");
+  if (!theta.compiled()) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const double expected = -2.0 + 2.0;
+  if (!Dune::FloatCmp::eq(theta.evaluate(mu), expected))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, theta.evaluate(mu));
+  const auto serialized_mu = mu.serialize();
+  if (!Dune::FloatCmp::eq(theta.evaluate(serialized_mu.data(), serialized_mu.size()), expected))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // concurrent evaluation
+  std::vector< double > results(4, 0.0);
+  std::vector< std::thread > threads;
+  for (size_t tt = 0; tt < results.size(); ++tt)
+    threads.emplace_back([&, tt]() {
+      std::vector< double > local_mu = {2.0, 0.5, double(tt)};
+      for (size_t ii = 0; ii < 1000; ++ii)
+        results[tt] += theta.evaluate(local_mu.data(), local_mu.size());
+    });
+  for (auto& thread : threads)
+    thread.join();
+  for (size_t tt = 0; tt < results.size(); ++tt)
+    if (!Dune::FloatCmp::eq(results[tt], 1000.0 * (-2.0 + std::max(double(tt), 1.0) / 1.5)))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, results[tt]);
+  // not compilable expressions are still evaluated by the interpreter
+  ParameterFunctional theta2(mu.type(), "diffusion + force");
+  if (theta2.compiled()) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // copies share the compiled expression
+  const ParameterFunctional theta3(theta);
+  theta2 = theta3;
+  if (!theta2.compiled() || theta2 != theta) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(theta2.evaluate(mu), expected))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, theta2.evaluate(mu));
+}
+
+TEST(Functional, Parameters_Functional_Compiled_Matches_Interpreted)
+{
+  // the compiled tape has to agree with the interpreter of mathexpr it replaces
+  const ParameterType type({"diffusion", "force"}, {1, 2});
+  const std::vector< std::string > variables = {"diffusion[0]", "force[0]", "force[1]"};
+  const std::vector< std::string > expressions = {
+    "diffusion[0] + force[0] * force[1]",
+    "diffusion[0] - force[0] - force[1]",
+    "diffusion[0] / force[0] / force[1]",
+    "-diffusion[0]^2",
+    "-diffusion[0] * force[0] + force[1]",
+    "2^diffusion[0] * 3",
+    "diffusion[0]^2 + force[0]^3",
+    "(diffusion[0] + force[0]) * (1.5 - force[1])",
+    "1e-2 * diffusion[0] + 2.5e1",
+    "abs(force[0]) + sqrt(diffusion[0]) + exp(force[1])",
+    "log(diffusion[0]) * sin(force[0]) - cos(force[1])",
+    "tan(force[0]) + atan(force[1] / diffusion[0])",
+    "-(diffusion[0] - force[0]) / (1 + abs(force[1]))"};
+  const std::vector< std::vector< double > > mus = {{0.5, 0.25, 0.75}, {0.1, -0.3, 0.9}, {2.0, 0.6, -0.2}};
+  std::vector< double > arguments(variables.size(), 0.0);
+  std::vector< std::unique_ptr< RVar > > rvars;
+  std::vector< RVar* > vararray;
+  for (size_t ii = 0; ii < variables.size(); ++ii) {
+    rvars.emplace_back(new RVar(variables[ii].c_str(), &(arguments[ii])));
+    vararray.push_back(rvars[ii].get());
+  }
+  for (const auto& expression : expressions) {
+    const auto compiled = internal::CompiledExpression::compile(expression, type);
+    if (!compiled) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, expression);
+    ROperation interpreted(expression.c_str(), int(vararray.size()), vararray.data());
+    for (const auto& mu : mus) {
+      std::copy(mu.begin(), mu.end(), arguments.begin());
+      const double expected = interpreted.Val();
+      const double result = compiled->evaluate(mu.data());
+      if (!Dune::FloatCmp::eq(result, expected))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   expression << ": " << result << " (compiled) != " << expected << " (interpreted)");
+    }
+  }
+  // scalar components may be used without [], which the interpreter does not support
+  const auto bare = internal::CompiledExpression::compile("-diffusion^2 + force[0]", type);
+  const auto indexed = internal::CompiledExpression::compile("-diffusion[0]^2 + force[0]", type);
+  if (!bare || !indexed) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  for (const auto& mu : mus)
+    if (bare->evaluate(mu.data()) != indexed->evaluate(mu.data()))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+TEST(Functional, Parameters_Functional_Batch)
+{
+  const ParameterType type({"diffusion", "force"}, {1, 2});
+  const ParameterFunctional theta(type, "diffusion * exp(force[0]) - force[1]");
+  const size_t num_mus = 150;
+  std::vector< double > mus;
+  for (size_t nn = 0; nn < num_mus; ++nn) {
+    const Parameter mu = {{"diffusion", "force"}, {{0.1 * nn}, {std::sin(double(nn)), 1.0 / (nn + 1.0)}}};
+    const auto serialized_mu = mu.serialize();
+    mus.insert(mus.end(), serialized_mu.begin(), serialized_mu.end());
+  }
+  const auto results = theta.evaluate_batch(mus);
+  if (results.size() != num_mus) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, results.size());
+  for (size_t nn = 0; nn < num_mus; ++nn)
+    if (!Dune::FloatCmp::eq(results[nn], theta.evaluate(mus.data() + 3 * nn, 3)))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, nn);
+  try {
+    theta.evaluate_batch(std::vector< double >(4, 1.0));
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (Stuff::Exceptions::shapes_do_not_match&) {}
+}
@@ -0,0 +1,139 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <map>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/parameters/sampling.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+static ParameterType create_type()
+{
+  const Parameter mu = {{"diffusion", "force"}, {{1.0}, {0.0, 0.0}}};
+  return mu.type();
+}
+
+static void check_bounds(const ParameterSampler& sampler,
+                         const std::vector< double >& samples,
+                         const std::vector< double >& mins,
+                         const std::vector< double >& maxs)
+{
+  for (size_t ii = 0; ii < samples.size(); ++ii)
+    if (samples[ii] < mins[ii % sampler.dim()] || samples[ii] > maxs[ii % sampler.dim()])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, samples[ii] << " is out of bounds!");
+}
+
+TEST(ParameterSampler, uniform)
+{
+  const ParameterType tt = create_type();
+  std::map< std::string, ParameterSampler::RangeType > ranges;
+  ranges["diffusion"] = ParameterSampler::RangeType(0.1, 1.0);
+  ranges["force"] = ParameterSampler::RangeType(-1.0, 1.0);
+  const ParameterSampler sampler(tt, ranges);
+  if (sampler.dim() != 3) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, sampler.dim());
+  const auto samples = sampler.uniform(3);
+  if (samples.size() != 27 * 3) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, samples.size());
+  check_bounds(sampler, samples, {0.1, -1.0, -1.0}, {1.0, 1.0, 1.0});
+  // the last entry varies fastest
+  const std::vector< double > first = {0.1, -1.0, -1.0};
+  const std::vector< double > second = {0.1, -1.0, 0.0};
+  const std::vector< double > last = {1.0, 1.0, 1.0};
+  for (size_t ii = 0; ii < 3; ++ii)
+    if (!Dune::FloatCmp::eq(samples[ii], first[ii])
+        || !Dune::FloatCmp::eq(samples[3 + ii], second[ii])
+        || !Dune::FloatCmp::eq(samples[26 * 3 + ii], last[ii]))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const auto center = sampler.uniform(1);
+  if (center.size() != 3 || !Dune::FloatCmp::eq(center[0], 0.55) || !Dune::FloatCmp::eq(center[1], 0.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // (2^32)^3 points do not fit into a size_t
+  try {
+    sampler.uniform(size_t(1) << 32);
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the size of the grid overflowed silently!");
+  } catch (Stuff::Exceptions::index_out_of_range&) {}
+}
+
+TEST(ParameterSampler, random)
+{
+  const ParameterSampler sampler(create_type(), {0.1, -1.0, 2.0}, {1.0, 1.0, 2.5});
+  const auto samples = sampler.random(100, 42);
+  if (samples.size() != 300) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, samples.size());
+  check_bounds(sampler, samples, {0.1, -1.0, 2.0}, {1.0, 1.0, 2.5});
+  if (samples != sampler.random(100, 42)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (samples == sampler.random(100, 43)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+TEST(ParameterSampler, latin_hypercube)
+{
+  const size_t num = 50;
+  const ParameterSampler sampler(create_type(), -2.0, 3.0);
+  const auto samples = sampler.latin_hypercube(num, 7);
+  check_bounds(sampler, samples, {-2.0, -2.0, -2.0}, {3.0, 3.0, 3.0});
+  // each of the num intervals of each direction contains exactly one sample
+  for (size_t ii = 0; ii < sampler.dim(); ++ii) {
+    std::vector< size_t > counts(num, 0);
+    for (size_t nn = 0; nn < num; ++nn)
+      ++counts[std::min(size_t((samples[nn * sampler.dim() + ii] + 2.0) / 5.0 * num), num - 1)];
+    for (size_t count : counts)
+      if (count != 1) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, count);
+  }
+}
+
+TEST(ParameterSampler, sobol)
+{
+  const size_t num = 64;
+  const ParameterSampler sampler(create_type(), 0.0, 1.0);
+  const auto samples = sampler.sobol(num);
+  check_bounds(sampler, samples, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+  for (size_t ii = 0; ii < sampler.dim(); ++ii)
+    if (samples[ii] != 0.0) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, samples[ii]);
+  // the second and third point of the sequence
+  const std::vector< double > expected = {0.5, 0.5, 0.5, 0.75, 0.25, 0.25};
+  for (size_t ii = 0; ii < expected.size(); ++ii)
+    if (!Dune::FloatCmp::eq(samples[3 + ii], expected[ii]))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, samples[3 + ii] << " vs. " << expected[ii]);
+  // the first 2^k points are stratified in each direction
+  for (size_t ii = 0; ii < sampler.dim(); ++ii) {
+    std::vector< size_t > counts(num, 0);
+    for (size_t nn = 0; nn < num; ++nn)
+      ++counts[size_t(samples[nn * sampler.dim() + ii] * num)];
+    for (size_t count : counts)
+      if (count != 1) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, count);
+  }
+  // skipping yields the tail of the sequence
+  const auto tail = sampler.sobol(num - 10, 10);
+  if (!std::equal(tail.begin(), tail.end(), samples.begin() + 10 * sampler.dim()))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+TEST(ParameterSampler, parameters)
+{
+  const ParameterType tt = create_type();
+  const ParameterSampler sampler(tt, 0.0, 1.0);
+  const auto samples = sampler.random(10);
+  const auto mus = sampler.parameters(samples);
+  if (mus.size() != 10) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, mus.size());
+  const ParameterFunctional theta(tt, "diffusion + 2*force[0] + 3*force[1]");
+  const auto thetas = theta.evaluate_batch(samples);
+  for (size_t nn = 0; nn < mus.size(); ++nn) {
+    if (mus[nn].type() != tt) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+    const auto serialized = mus[nn].serialize();
+    if (!std::equal(serialized.begin(), serialized.end(), samples.begin() + nn * 3))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+    if (!Dune::FloatCmp::eq(theta.evaluate(mus[nn]), thetas[nn]))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  }
+  EXPECT_THROW(sampler.parameters(std::vector< double >(4)), Stuff::Exceptions::shapes_do_not_match);
+}
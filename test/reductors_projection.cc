@@ -0,0 +1,107 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/reductors/projection.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseMatrix< double > MatrixType;
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+// large enough to span several blocks of the kernel
+static const size_t test_dim = 300;
+static const size_t test_size = 6;
+
+
+static std::shared_ptr< MatrixType > create_matrix(const double factor)
+{
+  auto ret = std::make_shared< MatrixType >(test_dim, test_dim);
+  for (size_t ii = 0; ii < test_dim; ++ii)
+    for (size_t jj = std::max(ii, size_t(1)) - 1; jj < std::min(test_dim, ii + 2); ++jj)
+      ret->set_entry(ii, jj, factor * (ii == jj ? 2. : -1.) + 0.01 * double(ii));
+  return ret;
+}
+
+
+static std::shared_ptr< VectorType > create_vector(const double factor)
+{
+  auto ret = std::make_shared< VectorType >(test_dim);
+  for (size_t ii = 0; ii < test_dim; ++ii)
+    ret->set_entry(ii, factor * std::sin(double(ii)));
+  return ret;
+}
+
+
+static std::vector< VectorType > create_basis()
+{
+  std::vector< VectorType > ret;
+  for (size_t nn = 0; nn < test_size; ++nn) {
+    VectorType vector(test_dim);
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      vector.set_entry(ii, std::cos(double((nn + 1) * ii)));
+    ret.push_back(vector);
+  }
+  return ret;
+}
+
+
+static void check(const MatrixType& reduced, const MatrixType& matrix, const std::vector< VectorType >& basis)
+{
+  VectorType tmp(test_dim);
+  for (size_t jj = 0; jj < basis.size(); ++jj) {
+    matrix.mv(basis[jj], tmp);
+    for (size_t ii = 0; ii < basis.size(); ++ii)
+      if (std::abs(reduced.get_entry(ii, jj) - basis[ii].dot(tmp)) > 1e-10)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, ii << ", " << jj);
+  }
+} // ... check(...)
+
+
+TEST(Projection, project_operator) {
+  const auto basis = create_basis();
+  LA::AffinelyDecomposedContainer< MatrixType > op(create_matrix(1.));
+  op.register_component(create_matrix(2.), new ParameterFunctional("diffusion", 1, "diffusion"));
+  op.register_component(create_matrix(-0.5), new ParameterFunctional("diffusion", 1, "exp(diffusion)"));
+  for (const size_t num_threads : {1, 2}) {
+    const Reductors::Projection< VectorType > projection(basis, num_threads);
+    const auto reduced = projection.project_operator(op);
+    if (!reduced.has_affine_part() || reduced.num_components() != 2)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, reduced.num_components());
+    check(*reduced.affine_part(), *op.affine_part(), basis);
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < 2; ++qq) {
+      check(*reduced.component(qq), *op.component(qq), basis);
+      if (reduced.coefficient(qq) != op.coefficient(qq))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, qq);
+    }
+  }
+}
+
+
+TEST(Projection, project_functional) {
+  const auto basis = create_basis();
+  LA::AffinelyDecomposedContainer< VectorType > functional;
+  functional.register_component(create_vector(1.), new ParameterFunctional("force", 1, "force"));
+  functional.register_component(create_vector(-3.), new ParameterFunctional("force", 1, "force * force"));
+  const Reductors::Projection< VectorType > projection(basis);
+  const auto reduced = projection.project_functional(functional);
+  if (reduced.has_affine_part() || reduced.num_components() != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, reduced.num_components());
+  for (DUNE_STUFF_SSIZE_T qq = 0; qq < 2; ++qq)
+    for (size_t nn = 0; nn < test_size; ++nn)
+      if (std::abs(reduced.component(qq)->get_entry(nn) - basis[nn].dot(*functional.component(qq))) > 1e-10)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, qq << ", " << nn);
+}
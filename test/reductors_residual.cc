@@ -0,0 +1,99 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/reductors/residual.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseMatrix< double > MatrixType;
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+static const size_t test_dim = 20;
+
+
+static std::shared_ptr< MatrixType > create_matrix(const double diagonal, const double off_diagonal)
+{
+  auto ret = std::make_shared< MatrixType >(test_dim, test_dim);
+  for (size_t ii = 0; ii < test_dim; ++ii) {
+    ret->set_entry(ii, ii, diagonal);
+    if (ii > 0)
+      ret->set_entry(ii, ii - 1, off_diagonal);
+    if (ii + 1 < test_dim)
+      ret->set_entry(ii, ii + 1, off_diagonal);
+  }
+  return ret;
+}
+
+
+struct ConstantCoercivity
+{
+  double lower_bound(const Parameter& /*mu*/) const
+  {
+    return value;
+  }
+
+  double value;
+};
+
+
+TEST(ResidualNorm, matches_high_dimensional_residual) {
+  LA::AffinelyDecomposedContainer< MatrixType > op(create_matrix(2., -1.));
+  op.register_component(create_matrix(1., 0.), new ParameterFunctional("diffusion", 1, "diffusion"));
+  LA::AffinelyDecomposedContainer< VectorType > rhs;
+  auto force = std::make_shared< VectorType >(test_dim, 1.);
+  rhs.register_component(force, new ParameterFunctional("force", 1, "force"));
+  std::vector< VectorType > basis;
+  // enough terms for more than one block of Riesz representatives
+  for (size_t nn = 0; nn < 9; ++nn) {
+    VectorType vector(test_dim);
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      vector.set_entry(ii, std::sin(double((nn + 1) * (ii + 1))));
+    basis.push_back(vector);
+  }
+  // the residual is measured in the dual of the scaled euclidean product (x, y) = 2 x^T y
+  const auto product = create_matrix(2., 0.);
+  const Reductors::ResidualNorm< MatrixType, VectorType > residual_norm(op, rhs, basis, *product);
+  if (residual_norm.num_terms() != 1 + 2 * basis.size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, residual_norm.num_terms());
+  for (const double value : {0.1, 1., 5.}) {
+    const Parameter mu(std::vector< std::string >{"diffusion", "force"}, {{value}, {2. * value}});
+    VectorType u_N(basis.size());
+    for (size_t nn = 0; nn < basis.size(); ++nn)
+      u_N.set_entry(nn, value * double(nn + 1));
+    // reference
+    VectorType u(test_dim);
+    for (size_t nn = 0; nn < basis.size(); ++nn)
+      u.axpy(u_N.get_entry(nn), basis[nn]);
+    VectorType residual = rhs.freeze_parameter(Parameter("force", 2. * value));
+    VectorType tmp(test_dim);
+    op.freeze_parameter(Parameter("diffusion", value)).mv(u, tmp);
+    residual.axpy(-1., tmp);
+    const double expected = std::sqrt(residual.dot(residual) / 2.);
+    const double actual = residual_norm.apply(mu, u_N);
+    if (std::abs(actual - expected) > 1e-10 * std::max(1., expected))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, actual << " vs. " << expected);
+    const double estimate = Reductors::estimate_error(residual_norm, ConstantCoercivity{0.5}, mu, u_N);
+    if (std::abs(estimate - 2. * actual) > 1e-12 * std::max(1., actual))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, estimate);
+    try {
+      Reductors::estimate_error(residual_norm, ConstantCoercivity{0.}, mu, u_N);
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "a zero lower bound was accepted!");
+    } catch (Stuff::Exceptions::wrong_input_given&) {}
+  }
+}
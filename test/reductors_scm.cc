@@ -0,0 +1,179 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/reductors/scm.hh>
+
+using namespace Dune;
+using namespace Pymor;
+
+typedef Stuff::LA::CommonDenseMatrix< double > MatrixType;
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+static const size_t test_dim = 10;
+
+
+/**
+ * \brief The smallest eigenvalue of the symmetric tridiagonal matrix with the given constant off-diagonal, by
+ *        bisection of the Sturm sequence.
+ */
+static double minimal_eigenvalue(const std::vector< double >& diagonal, const double off_diagonal)
+{
+  // the number of eigenvalues smaller than x is the number of negative pivots of the LDL^T decomposition of T - x I
+  const auto num_smaller = [&](const double x) {
+    size_t ret = 0;
+    double pivot = 1.;
+    for (size_t ii = 0; ii < diagonal.size(); ++ii) {
+      pivot = diagonal[ii] - x - ((ii > 0) ? off_diagonal * off_diagonal / pivot : 0.);
+      if (pivot == 0.)
+        pivot = -1e-300;
+      if (pivot < 0.)
+        ++ret;
+    }
+    return ret;
+  };
+  double lower = *std::min_element(diagonal.begin(), diagonal.end()) - 2. * std::abs(off_diagonal);
+  double upper = *std::max_element(diagonal.begin(), diagonal.end()) + 2. * std::abs(off_diagonal);
+  for (size_t it = 0; it < 200 && upper - lower > 1e-15 * std::max(1., std::abs(lower)); ++it) {
+    const double middle = 0.5 * (lower + upper);
+    if (num_smaller(middle) > 0)
+      upper = middle;
+    else
+      lower = middle;
+  }
+  return lower;
+} // ... minimal_eigenvalue(...)
+
+
+TEST(simplex_minimize, solves_small_programs) {
+  std::vector< double > x;
+  // min -x - y s.t. x + 2y <= 4, 3x + y <= 6
+  const double first = Reductors::internal::simplex_minimize< double >({-1., -1.}, {1., 2., 3., 1.}, {4., 6.}, x);
+  if (std::abs(first + 2.8) > 1e-12 || std::abs(x[0] - 1.6) > 1e-12 || std::abs(x[1] - 1.2) > 1e-12)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, first);
+  // min 2x + 3y s.t. x >= 1, y >= 2, x <= 3 (requires the first phase)
+  const double second = Reductors::internal::simplex_minimize< double >({2., 3.},
+                                                                        {-1., 0., 0., -1., 1., 0.},
+                                                                        {-1., -2., 3.},
+                                                                        x);
+  if (std::abs(second - 8.) > 1e-12)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, second);
+}
+
+
+TEST(SuccessiveConstraints, bounds_the_coercivity_constant) {
+  // A(mu) = A_0 + diffusion A_1 + (1 - diffusion) A_2, with symmetric tridiagonal A_1 and diagonal A_0, A_2
+  auto matrix_0 = std::make_shared< MatrixType >(test_dim, test_dim);
+  auto matrix_1 = std::make_shared< MatrixType >(test_dim, test_dim);
+  auto matrix_2 = std::make_shared< MatrixType >(test_dim, test_dim);
+  for (size_t ii = 0; ii < test_dim; ++ii) {
+    matrix_0->set_entry(ii, ii, 0.1);
+    matrix_1->set_entry(ii, ii, 2.);
+    if (ii > 0)
+      matrix_1->set_entry(ii, ii - 1, -1.);
+    if (ii + 1 < test_dim)
+      matrix_1->set_entry(ii, ii + 1, -1.);
+    matrix_2->set_entry(ii, ii, double(ii + 1) / double(test_dim));
+  }
+  LA::AffinelyDecomposedContainer< MatrixType > op(matrix_0);
+  op.register_component(matrix_1, new ParameterFunctional("diffusion", 1, "diffusion"));
+  op.register_component(matrix_2, new ParameterFunctional("diffusion", 1, "1 - diffusion"));
+  MatrixType product(test_dim, test_dim);
+  for (size_t ii = 0; ii < test_dim; ++ii)
+    product.set_entry(ii, ii, 1.);
+  std::vector< Parameter > training_set;
+  for (const double value : {0.1, 0.4, 0.7, 0.9})
+    training_set.emplace_back("diffusion", value);
+  const Reductors::SuccessiveConstraints< MatrixType, VectorType > scm(op, product, training_set, 0, 1e-12, 100000, 2);
+  // the coercivity constant of A(mu), computed independently
+  const auto alpha = [](const double value) {
+    std::vector< double > diagonal(test_dim);
+    for (size_t ii = 0; ii < test_dim; ++ii)
+      diagonal[ii] = 0.1 + 2. * value + (1. - value) * double(ii + 1) / double(test_dim);
+    return minimal_eigenvalue(diagonal, -value);
+  };
+  // (up to the residual bound) exact at the training parameters, up to the accuracy of the bisection
+  for (size_t kk = 0; kk < training_set.size(); ++kk) {
+    const double expected = alpha(training_set[kk].get("diffusion")[0]);
+    const double lower = scm.lower_bound(training_set[kk]);
+    if (scm.alphas()[kk] > expected * (1. + 1e-14) || std::abs(scm.alphas()[kk] - expected) > 1e-6 * expected)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, scm.alphas()[kk] << " vs. " << expected);
+    if (std::abs(lower - scm.alphas()[kk]) > 1e-6 * scm.alphas()[kk])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, lower << " vs. " << scm.alphas()[kk]);
+  }
+  // the bounds enclose the coercivity constant in between
+  for (const double value : {0.2, 0.5, 0.8}) {
+    const Parameter mu("diffusion", value);
+    const double expected = alpha(value);
+    const double lower = scm.lower_bound(mu);
+    const double upper = scm.upper_bound(mu);
+    if (lower > expected * (1. + 1e-14) || upper < expected - 1e-10 * expected)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 lower << " <= " << expected << " <= " << upper << " does not hold!");
+  }
+  // the eigensolvers report when they do not converge
+  try {
+    Reductors::SuccessiveConstraints< MatrixType, VectorType >(op, product, training_set, 0, 1e-12, 2);
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "max_iterations was exceeded silently!");
+  } catch (MathError&) {}
+}
+
+
+TEST(SuccessiveConstraints, handles_clustered_spectra) {
+  // A(mu) = 0.01 I + diffusion L with the finite difference laplacian L, the eigenvalues 2 - 2 cos(k pi / (n + 1)) of
+  // which cluster at both ends of the spectrum, as for any finite element discretization
+  const size_t dim = 100;
+  const double pi = std::acos(-1.);
+  auto identity = std::make_shared< MatrixType >(dim, dim);
+  auto laplacian = std::make_shared< MatrixType >(dim, dim);
+  for (size_t ii = 0; ii < dim; ++ii) {
+    identity->set_entry(ii, ii, 1.);
+    laplacian->set_entry(ii, ii, 2.);
+    if (ii > 0)
+      laplacian->set_entry(ii, ii - 1, -1.);
+    if (ii + 1 < dim)
+      laplacian->set_entry(ii, ii + 1, -1.);
+  }
+  LA::AffinelyDecomposedContainer< MatrixType > op(new MatrixType(*identity));
+  op.affine_part()->scal(0.01);
+  op.register_component(laplacian, new ParameterFunctional("diffusion", 1, "diffusion"));
+  std::vector< Parameter > training_set;
+  for (const double value : {0.5, 1.})
+    training_set.emplace_back("diffusion", value);
+  // the default max_iterations
+  const Reductors::SuccessiveConstraints< MatrixType, VectorType > scm(op, *identity, training_set, 0, 1e-10);
+  const double lambda_min = 2. - 2. * std::cos(pi / double(dim + 1));
+  const double lambda_max = 2. - 2. * std::cos(double(dim) * pi / double(dim + 1));
+  if (scm.sigma_min()[1] > lambda_min || scm.sigma_min()[1] < lambda_min - 1e-8)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, scm.sigma_min()[1] << " vs. " << lambda_min);
+  if (scm.sigma_max()[1] < lambda_max || scm.sigma_max()[1] > lambda_max + 1e-8)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, scm.sigma_max()[1] << " vs. " << lambda_max);
+  if (std::abs(scm.sigma_min()[0] - 0.01) > 1e-12 || std::abs(scm.sigma_max()[0] - 0.01) > 1e-12)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, scm.sigma_min()[0] << ", " << scm.sigma_max()[0]);
+  for (size_t kk = 0; kk < training_set.size(); ++kk) {
+    const double expected = 0.01 + training_set[kk].get("diffusion")[0] * lambda_min;
+    if (scm.alphas()[kk] > expected * (1. + 1e-14) || scm.alphas()[kk] < expected * (1. - 1e-8))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, scm.alphas()[kk] << " vs. " << expected);
+  }
+  const Parameter mu("diffusion", 0.75);
+  const double expected = 0.01 + 0.75 * lambda_min;
+  const double lower = scm.lower_bound(mu);
+  const double upper = scm.upper_bound(mu);
+  if (lower > expected * (1. + 1e-14) || upper < expected * (1. - 1e-10))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               lower << " <= " << expected << " <= " << upper << " does not hold!");
+}